@@ -0,0 +1,223 @@
+#ifndef ANY_H
+#define ANY_H
+
+#include <new>          // For placement new
+#include <string>
+#include <type_traits>
+#include <typeinfo>     // For bad_cast
+#include <stdexcept>
+#include <utility>
+#include "instrumentation.hpp"
+
+// type() is the only part that needs RTTI; without it (-fno-rtti) Any still
+// stores and casts, it just can't name what it holds
+#if defined(__cpp_rtti) || defined(__GXX_RTTI)
+#include <typeindex>
+#define ANY_RTTI 1
+#endif
+
+class Any {
+private:
+    // Small, nothrow-movable values live inline; everything else on the heap
+    static constexpr std::size_t INLINE_SIZE = 3 * sizeof(void*);
+
+    static constexpr instrumentation::component tag = instrumentation::component::any;
+
+    union Storage {
+        void* heap;
+        alignas(void*) unsigned char buffer[INLINE_SIZE];
+    };
+
+    template <typename T>
+    static constexpr bool fits_inline = sizeof(T) <= INLINE_SIZE &&
+                                        alignof(void*) % alignof(T) == 0 &&
+                                        std::is_nothrow_move_constructible_v<T>;
+
+    // One static table of operations per stored type, instead of a virtual
+    // Holder hierarchy. Its address doubles as the type's identity, so type
+    // checks are a pointer comparison and need no RTTI.
+    struct VTable {
+        void (*destroy)(Storage& s) noexcept;
+        void (*copy)(const Storage& src, Storage& dst);
+        void (*move)(Storage& src, Storage& dst) noexcept; // Leaves src empty
+#ifdef ANY_RTTI
+        const std::type_info& (*type)();
+#endif
+    };
+
+    template <typename T>
+    struct InlineOps {
+        static T* get(Storage& s) { return std::launder(reinterpret_cast<T*>(s.buffer)); }
+        static const T* get(const Storage& s) { return std::launder(reinterpret_cast<const T*>(s.buffer)); }
+
+        static void destroy(Storage& s) noexcept { get(s)->~T(); }
+        static void copy(const Storage& src, Storage& dst) {
+            new (dst.buffer) T(*get(src));
+            instrumentation::on_placement(tag, true);
+            instrumentation::on_copy(tag, sizeof(T));
+        }
+        static void move(Storage& src, Storage& dst) noexcept {
+            new (dst.buffer) T(std::move(*get(src)));
+            get(src)->~T();
+            instrumentation::on_move(tag, sizeof(T));
+        }
+#ifdef ANY_RTTI
+        static const std::type_info& type() { return typeid(T); }
+#endif
+    };
+
+    template <typename T>
+    struct HeapOps {
+        static T* get(Storage& s) { return static_cast<T*>(s.heap); }
+        static const T* get(const Storage& s) { return static_cast<const T*>(s.heap); }
+
+        static void destroy(Storage& s) noexcept {
+            instrumentation::on_free(tag, sizeof(T));
+            delete get(s);
+        }
+        static void copy(const Storage& src, Storage& dst) {
+            dst.heap = new T(*get(src));
+            instrumentation::on_alloc(tag, sizeof(T));
+            instrumentation::on_placement(tag, false);
+            instrumentation::on_copy(tag, sizeof(T));
+        }
+        static void move(Storage& src, Storage& dst) noexcept { dst.heap = src.heap; }
+#ifdef ANY_RTTI
+        static const std::type_info& type() { return typeid(T); }
+#endif
+    };
+
+    template <typename T>
+    using Ops = std::conditional_t<fits_inline<T>, InlineOps<T>, HeapOps<T>>;
+
+    template <typename T>
+#ifdef ANY_RTTI
+    static constexpr VTable vtable_for = {Ops<T>::destroy, Ops<T>::copy, Ops<T>::move, Ops<T>::type};
+#else
+    static constexpr VTable vtable_for = {Ops<T>::destroy, Ops<T>::copy, Ops<T>::move};
+#endif
+
+    Storage storage;
+    const VTable* vtable;
+
+    // Values are stored by their decayed type, so any_cast<const T> must
+    // look up the table of T
+    template <typename T>
+    bool holds() const {
+        return vtable == &vtable_for<std::remove_cv_t<T>>;
+    }
+
+    template <typename T>
+    const T* get() const {
+        return Ops<std::remove_cv_t<T>>::get(storage);
+    }
+
+public:
+    Any() : vtable(nullptr) {}
+
+    template <typename T, typename V = std::decay_t<T>,
+              typename = std::enable_if_t<!std::is_same_v<V, Any>>>
+    Any(T&& value) : vtable(&vtable_for<V>) {
+        if constexpr (fits_inline<V>) {
+            new (storage.buffer) V(std::forward<T>(value));
+        } else {
+            storage.heap = new V(std::forward<T>(value));
+            instrumentation::on_alloc(tag, sizeof(V));
+        }
+        instrumentation::on_placement(tag, fits_inline<V>);
+        if constexpr (std::is_lvalue_reference_v<T>) {
+            instrumentation::on_copy(tag, sizeof(V));
+        } else {
+            instrumentation::on_move(tag, sizeof(V));
+        }
+    }
+
+    Any(const Any& other) : vtable(nullptr) {
+        if (other.vtable) {
+            other.vtable->copy(other.storage, storage);
+            vtable = other.vtable;
+        }
+    }
+
+    // Heap values just hand over their pointer; inline values are moved across
+    Any(Any&& other) noexcept : vtable(other.vtable) {
+        if (vtable) {
+            vtable->move(other.storage, storage);
+            other.vtable = nullptr;
+        }
+    }
+
+    Any& operator=(const Any& other) {
+        if (this != &other) {
+            Any(other).swap(*this);
+        }
+        return *this;
+    }
+
+    Any& operator=(Any&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.vtable) {
+                other.vtable->move(other.storage, storage);
+                vtable = other.vtable;
+                other.vtable = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~Any() {
+        reset();
+    }
+
+    void swap(Any& other) noexcept {
+        Any tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    void reset() {
+        if (vtable) {
+            vtable->destroy(storage);
+            vtable = nullptr;
+        }
+    }
+
+    bool has_value() const {
+        return vtable != nullptr;
+    }
+
+#ifdef ANY_RTTI
+    // Only needed for printing or comparing against typeid; casts don't use it
+    std::type_index type() const {
+        return has_value() ? std::type_index(vtable->type()) : std::type_index(typeid(void));
+    }
+#endif
+
+    template <typename T>
+    friend const T* any_cast(const Any* any) noexcept;
+};
+
+// Returns nullptr on a type mismatch
+template <typename T>
+const T* any_cast(const Any* any) noexcept {
+    if (!any || !any->holds<T>()) {
+        return nullptr;
+    }
+    return any->get<T>();
+}
+
+template <typename T>
+T* any_cast(Any* any) noexcept {
+    return const_cast<T*>(any_cast<T>(static_cast<const Any*>(any)));
+}
+
+template <typename T>
+T any_cast(const Any& any) {
+    if (const T* value = any_cast<T>(&any)) {
+        return *value;
+    }
+    throw std::bad_cast();
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "any.hpp"
+#include "shared_pointer.hpp"
+#include "string_sso.hpp"
+#include "vector.hpp"
+
+// Build with -DPROBLEMS_INSTRUMENT (and -DPROBLEMS_INSTRUMENT_PERF for
+// hardware counters) to see the counts; otherwise the hooks compile away.
+int main() {
+    using instrumentation::component;
+    using instrumentation::counter;
+
+    {
+        instrumentation::perf_scope scope(component::vector);
+        Vector<int> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        Vector<int> copy = v;
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        SmallVector<int, 4> small;
+        for (int j = 0; j < i % 8; ++j) {
+            small.push_back(j);
+        }
+    }
+
+    {
+        instrumentation::perf_scope scope(component::string_sso);
+        String id("u42");
+        String note("a transaction note that is too long for SSO");
+        for (int i = 0; i < 4; ++i) {
+            id += "-tx";
+        }
+        String copy = note;
+    }
+
+    // Refcount traffic from several threads is summed by collect()
+    SharedPtr<int> shared = make_shared<int>(7);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([shared] {
+            for (int i = 0; i < 1000; ++i) {
+                SharedPtr<int> copy = shared;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    Any small_value = 42;
+    Any large_value = std::string(64, 'x');
+    Any copy = large_value;
+
+    instrumentation::snapshot before = instrumentation::collect();
+    for (int i = 0; i < 10; ++i) {
+        Any temporary = std::string(40, static_cast<char>('a' + i)); // Too big to stay inline
+    }
+    instrumentation::snapshot delta = instrumentation::collect() - before;
+
+    std::cout << "All components:\n";
+    instrumentation::report(std::cout);
+    std::cout << "Any allocations in the last loop: " << delta.get(component::any, counter::allocations) << "\n";
+    std::cout << "SharedPtr refcount increments: "
+              << instrumentation::collect().get(component::shared_pointer, counter::refcount_increments) << "\n";
+    std::cout << "perf counters available: " << std::boolalpha << instrumentation::perf_available() << "\n";
+
+    return 0;
+}
@@ -0,0 +1,396 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Opt-in counters for the container types: allocations and frees, bytes
+// copied and moved, growth events, inline (SSO) vs heap placement and
+// refcount traffic, kept per component.
+//
+// Everything is compiled out unless PROBLEMS_INSTRUMENT is defined: the hooks
+// below are then empty inline functions and cost nothing. When enabled, each
+// thread bumps its own counters (plain relaxed load + store, no locked RMW)
+// and collect() sums every live thread plus the totals of threads that have
+// exited.
+//
+// Defining PROBLEMS_INSTRUMENT_PERF as well (Linux only) makes perf_scope
+// read hardware counters through perf_event_open and charge the cache misses,
+// cycles and instructions spent inside the scope to a component. If the
+// kernel refuses (e.g. perf_event_paranoid), perf_scope silently records
+// nothing.
+
+#if defined(PROBLEMS_INSTRUMENT_PERF) && !defined(PROBLEMS_INSTRUMENT)
+#error "PROBLEMS_INSTRUMENT_PERF requires PROBLEMS_INSTRUMENT"
+#endif
+
+#ifdef PROBLEMS_INSTRUMENT
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+#if defined(PROBLEMS_INSTRUMENT_PERF) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define INSTRUMENTATION_PERF 1
+#endif
+
+namespace instrumentation {
+
+enum class component : std::size_t {
+    vector,
+    small_vector,
+    string,         // String, StringBuilder and Rope leaves in string.hpp
+    shared_string,
+    string_sso,
+    shared_pointer, // SharedPtr, WeakPtr, AtomicSharedPtr and IntrusivePtr
+    any,
+    count
+};
+
+enum class counter : std::size_t {
+    allocations,
+    frees,
+    bytes_allocated,
+    bytes_freed,
+    bytes_copied,
+    bytes_moved,
+    growths,
+    inline_hits,    // Values that fit the inline buffer (SSO, Any, SmallVector)
+    heap_hits,      // Values that had to go to the heap
+    refcount_increments,
+    refcount_decrements,
+    perf_samples,
+    cache_misses,
+    cycles,
+    instructions,
+    count
+};
+
+constexpr std::size_t component_count = static_cast<std::size_t>(component::count);
+constexpr std::size_t counter_count = static_cast<std::size_t>(counter::count);
+
+inline const char* name(component c) {
+    static const char* const names[component_count] = {
+        "Vector", "SmallVector", "String", "SharedString", "String (SSO)", "SharedPtr", "Any"};
+    return names[static_cast<std::size_t>(c)];
+}
+
+inline const char* name(counter k) {
+    static const char* const names[counter_count] = {
+        "allocations", "frees", "bytes_allocated", "bytes_freed", "bytes_copied", "bytes_moved",
+        "growths", "inline_hits", "heap_hits", "refcount_increments", "refcount_decrements",
+        "perf_samples", "cache_misses", "cycles", "instructions"};
+    return names[static_cast<std::size_t>(k)];
+}
+
+// Point-in-time totals, as returned by collect()
+struct snapshot {
+    std::uint64_t values[component_count][counter_count] = {};
+
+    std::uint64_t get(component c, counter k) const {
+        return values[static_cast<std::size_t>(c)][static_cast<std::size_t>(k)];
+    }
+
+    // Share of placements that stayed inline, or -1 if there were none
+    double inline_rate(component c) const {
+        std::uint64_t total = get(c, counter::inline_hits) + get(c, counter::heap_hits);
+        return total ? static_cast<double>(get(c, counter::inline_hits)) / total : -1.0;
+    }
+
+    snapshot operator-(const snapshot& earlier) const {
+        snapshot delta;
+        for (std::size_t c = 0; c < component_count; ++c) {
+            for (std::size_t k = 0; k < counter_count; ++k) {
+                delta.values[c][k] = values[c][k] - earlier.values[c][k];
+            }
+        }
+        return delta;
+    }
+};
+
+#ifdef PROBLEMS_INSTRUMENT
+
+constexpr bool enabled = true;
+
+namespace detail {
+
+struct thread_counters;
+
+// Never destroyed, so threads that exit during static destruction can
+// still fold their counts in
+struct registry {
+    std::mutex mutex;
+    std::vector<thread_counters*> live;
+    snapshot retired;
+
+    static registry& get() {
+        static registry* instance = new registry;
+        return *instance;
+    }
+};
+
+// Only the owning thread writes; collect() reads concurrently, hence atomics
+struct thread_counters {
+    std::atomic<std::uint64_t> values[component_count][counter_count] = {};
+
+    thread_counters() {
+        registry& r = registry::get();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(this);
+    }
+
+    ~thread_counters() {
+        registry& r = registry::get();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (std::size_t c = 0; c < component_count; ++c) {
+            for (std::size_t k = 0; k < counter_count; ++k) {
+                r.retired.values[c][k] += values[c][k].load(std::memory_order_relaxed);
+            }
+        }
+        for (std::size_t i = 0; i < r.live.size(); ++i) {
+            if (r.live[i] == this) {
+                r.live[i] = r.live.back();
+                r.live.pop_back();
+                break;
+            }
+        }
+    }
+};
+
+inline thread_counters& local() {
+    thread_local thread_counters counters;
+    return counters;
+}
+
+} // namespace detail
+
+inline void add(component c, counter k, std::uint64_t amount = 1) {
+    std::atomic<std::uint64_t>& value =
+        detail::local().values[static_cast<std::size_t>(c)][static_cast<std::size_t>(k)];
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+// Sums every thread's counters. Counts from other threads may lag by the
+// increments they are making right now, but are never torn.
+inline snapshot collect() {
+    detail::registry& r = detail::registry::get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    snapshot total = r.retired;
+    for (const detail::thread_counters* t : r.live) {
+        for (std::size_t c = 0; c < component_count; ++c) {
+            for (std::size_t k = 0; k < counter_count; ++k) {
+                total.values[c][k] += t->values[c][k].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return total;
+}
+
+#else
+
+constexpr bool enabled = false;
+
+inline void add(component, counter, std::uint64_t = 1) {}
+
+inline snapshot collect() {
+    return {};
+}
+
+#endif // PROBLEMS_INSTRUMENT
+
+// Hooks called by the containers
+
+inline void on_alloc(component c, std::size_t bytes) {
+    add(c, counter::allocations);
+    add(c, counter::bytes_allocated, bytes);
+}
+
+inline void on_free(component c, std::size_t bytes) {
+    add(c, counter::frees);
+    add(c, counter::bytes_freed, bytes);
+}
+
+inline void on_copy(component c, std::size_t bytes) {
+    add(c, counter::bytes_copied, bytes);
+}
+
+inline void on_move(component c, std::size_t bytes) {
+    add(c, counter::bytes_moved, bytes);
+}
+
+inline void on_growth(component c) {
+    add(c, counter::growths);
+}
+
+inline void on_placement(component c, bool is_inline) {
+    add(c, is_inline ? counter::inline_hits : counter::heap_hits);
+}
+
+inline void on_ref_inc(component c) {
+    add(c, counter::refcount_increments);
+}
+
+inline void on_ref_dec(component c) {
+    add(c, counter::refcount_decrements);
+}
+
+// ---------------------------------------------------------------- perf
+
+#ifdef INSTRUMENTATION_PERF
+
+namespace detail {
+
+// One counter group per thread: cache misses lead, cycles and instructions
+// follow, so a single read() returns all three measured over the same interval
+class perf_group {
+public:
+    perf_group() {
+        leader = open(PERF_COUNT_HW_CACHE_MISSES, -1);
+        if (leader < 0) return;
+        cycles = open(PERF_COUNT_HW_CPU_CYCLES, leader);
+        instructions = open(PERF_COUNT_HW_INSTRUCTIONS, leader);
+        if (cycles < 0 || instructions < 0) {
+            close_all();
+            return;
+        }
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~perf_group() {
+        close_all();
+    }
+
+    perf_group(const perf_group&) = delete;
+    perf_group& operator=(const perf_group&) = delete;
+
+    bool available() const {
+        return leader >= 0;
+    }
+
+    // {cache misses, cycles, instructions}; false if the read failed
+    bool read_values(std::uint64_t out[3]) const {
+        struct {
+            std::uint64_t count;
+            std::uint64_t values[3];
+        } data;
+        if (::read(leader, &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data.count != 3) {
+            return false;
+        }
+        for (int i = 0; i < 3; ++i) out[i] = data.values[i];
+        return true;
+    }
+
+    static perf_group& local() {
+        thread_local perf_group group;
+        return group;
+    }
+
+private:
+    static int open(std::uint64_t config, int group_fd) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = group_fd < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    void close_all() {
+        if (instructions >= 0) ::close(instructions);
+        if (cycles >= 0) ::close(cycles);
+        if (leader >= 0) ::close(leader);
+        leader = cycles = instructions = -1;
+    }
+
+    int leader = -1;
+    int cycles = -1;
+    int instructions = -1;
+};
+
+} // namespace detail
+
+inline bool perf_available() {
+    return detail::perf_group::local().available();
+}
+
+// Charges the hardware events counted while it is alive to one component
+class perf_scope {
+public:
+    explicit perf_scope(component _c) : c(_c) {
+        const detail::perf_group& group = detail::perf_group::local();
+        started = group.available() && group.read_values(start);
+    }
+
+    ~perf_scope() {
+        std::uint64_t end[3];
+        if (!started || !detail::perf_group::local().read_values(end)) return;
+        add(c, counter::perf_samples);
+        add(c, counter::cache_misses, end[0] - start[0]);
+        add(c, counter::cycles, end[1] - start[1]);
+        add(c, counter::instructions, end[2] - start[2]);
+    }
+
+    perf_scope(const perf_scope&) = delete;
+    perf_scope& operator=(const perf_scope&) = delete;
+
+private:
+    component c;
+    bool started;
+    std::uint64_t start[3];
+};
+
+#else
+
+inline bool perf_available() {
+    return false;
+}
+
+class perf_scope {
+public:
+    explicit perf_scope(component) {}
+
+    perf_scope(const perf_scope&) = delete;
+    perf_scope& operator=(const perf_scope&) = delete;
+};
+
+#endif // INSTRUMENTATION_PERF
+
+// ---------------------------------------------------------------- report
+
+// One line per component that saw any activity
+inline void report(std::ostream& out, const snapshot& s = collect()) {
+    if (!enabled) {
+        out << "instrumentation disabled (build with -DPROBLEMS_INSTRUMENT)\n";
+        return;
+    }
+    for (std::size_t i = 0; i < component_count; ++i) {
+        component c = static_cast<component>(i);
+        bool active = false;
+        for (std::size_t k = 0; k < counter_count; ++k) active = active || s.values[i][k] != 0;
+        if (!active) continue;
+
+        out << name(c) << ":";
+        for (std::size_t k = 0; k < counter_count; ++k) {
+            if (s.values[i][k] != 0) out << ' ' << name(static_cast<counter>(k)) << '=' << s.values[i][k];
+        }
+        double rate = s.inline_rate(c);
+        if (rate >= 0) out << " inline_rate=" << static_cast<int>(rate * 100 + 0.5) << '%';
+        if (s.get(c, counter::instructions) != 0) {
+            out << " misses_per_kinstr=" << 1000.0 * s.get(c, counter::cache_misses) / s.get(c, counter::instructions);
+        }
+        out << '\n';
+    }
+}
+
+} // namespace instrumentation
+
+#endif
@@ -1,89 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <thread>
+#include <vector>
+#include "shared_pointer.hpp"
 
-template <typename T>
-class SharedPtr {
-private:
-    T* ptr;
-    int* ref_count;
+struct CachedRecord : RefCounted<CachedRecord> {
+    int key;
 
-public:
-    // Default constructor
-    SharedPtr() : ptr(nullptr), ref_count(new int(0)) {}
+    explicit CachedRecord(int k) : key(k) {}
+};
 
-    // Constructor with raw pointer
-    explicit SharedPtr(T* p) : ptr(p), ref_count(new int(1)) {}
+struct Config {
+    int version;
 
-    // Copy constructor (increases reference count)
-    SharedPtr(const SharedPtr& other) : ptr(other.ptr), ref_count(other.ref_count) {
-        if (ptr) {
-            (*ref_count)++;
-        }
-    }
+    explicit Config(int v) : version(v) {}
+};
 
-    // Move constructor (steals ownership)
-    SharedPtr(SharedPtr&& other) noexcept : ptr(other.ptr), ref_count(other.ref_count) {
-        other.ptr = nullptr;
-        other.ref_count = nullptr;
+// Readers load() in a loop while a writer keeps republishing the same two
+// blocks. A reader whose ticket was converted must not leave the counts
+// off by one, whichever installation of its block it finds afterwards.
+// Ticket errors only show once the slot is gone and has handed back
+// everything it held, so the counts are checked both before and after.
+bool republish_keeps_counts() {
+    SharedPtr<int> a = make_shared<int>(1);
+    SharedPtr<int> b = make_shared<int>(2);
+    {
+        AtomicSharedPtr<int> slot(a);
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 8; ++r) {
+            readers.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    SharedPtr<int> seen = slot.load();
+                    if (*seen != 1 && *seen != 2) std::abort();
+                }
+            });
+        }
+        for (int i = 0; i < 2000000; ++i) {
+            slot.store(b);
+            slot.store(a);
+        }
+        stop = true;
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        if (a.use_count() != 2 || b.use_count() != 1) { // a is also held by the slot
+            return false;
+        }
     }
+    return a.use_count() == 1 && b.use_count() == 1;
+}
 
-    // Copy assignment
-    SharedPtr& operator=(const SharedPtr& other) {
-        if (this != &other) {
-            release();
-            ptr = other.ptr;
-            ref_count = other.ref_count;
-            if (ptr) {
-                (*ref_count)++;
+// Same, but the writer republishes in bursts of 2048 stores and then sleeps,
+// so readers get preempted in the middle of load() and resume only after the
+// same block has been installed again thousands of times. A scheme that told
+// installations apart by a wrapping counter would let such a reader give its
+// converted ticket back to a later installation.
+bool stalled_readers_keep_counts() {
+    SharedPtr<int> a = make_shared<int>(1);
+    SharedPtr<int> b = make_shared<int>(2);
+    {
+        AtomicSharedPtr<int> slot(a);
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 32; ++r) {
+            readers.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    SharedPtr<int> seen = slot.load();
+                    if (*seen != 1 && *seen != 2) std::abort();
+                }
+            });
+        }
+        for (int burst = 0; burst < 300; ++burst) {
+            for (int i = 0; i < 1024; ++i) {
+                slot.store(b);
+                slot.store(a);
             }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
         }
-        return *this;
-    }
-
-    // Move assignment
-    SharedPtr& operator=(SharedPtr&& other) noexcept {
-        if (this != &other) {
-            release();
-            ptr = other.ptr;
-            ref_count = other.ref_count;
-            other.ptr = nullptr;
-            other.ref_count = nullptr;
+        stop = true;
+        for (std::thread& reader : readers) {
+            reader.join();
         }
-        return *this;
-    }
-
-    // Destructor
-    ~SharedPtr() {
-        release();
-    }
-
-    // Dereference operator
-    T& operator*() const {
-        return *ptr;
-    }
-
-    // Arrow operator
-    T* operator->() const {
-        return ptr;
-    }
-
-    // Get raw pointer
-    T* get() const {
-        return ptr;
-    }
-
-    // Get reference count
-    int use_count() const {
-        return ptr ? *ref_count : 0;
-    }
-
-    // Release function to manage reference count
-    void release() {
-        if (ptr && --(*ref_count) == 0) {
-            delete ptr;
-            delete ref_count;
+        if (a.use_count() != 2 || b.use_count() != 1) {
+            return false;
         }
     }
-};
+    return a.use_count() == 1 && b.use_count() == 1;
+}
 
 int main() {
     SharedPtr<int> sp1(new int(42));
@@ -104,5 +110,31 @@ int main() {
 
     std::cout << "After sp4 is destroyed, sp1 use_count: " << sp1.use_count() << "\n";
 
+    SharedPtr<int> sp5 = make_shared<int>(7);  // Object and count in one allocation
+    std::cout << "make_shared value: " << *sp5 << ", use_count: " << sp5.use_count() << "\n";
+
+    WeakPtr<int> weak = sp5;
+    std::cout << "WeakPtr expired? " << std::boolalpha << weak.expired() << ", locked value: " << *weak.lock() << "\n";
+    sp5.reset();
+    std::cout << "After reset, expired? " << weak.expired() << "\n";
+
+    IntrusivePtr<CachedRecord> record = make_intrusive<CachedRecord>(1);
+    IntrusivePtr<CachedRecord> record_copy = record;
+    std::cout << "IntrusivePtr use_count: " << record.use_count() << "\n";
+
+    AtomicSharedPtr<Config> published(make_shared<Config>(0));
+    std::cout << "AtomicSharedPtr lock-free? " << published.is_lock_free() << "\n";
+
+    published.store(make_shared<Config>(1));
+    std::cout << "Published config version: " << published.load()->version << "\n";
+
+    bool counts_ok = republish_keeps_counts();
+    std::cout << "Republish stress keeps counts? " << counts_ok << "\n";
+    bool stalled_ok = stalled_readers_keep_counts();
+    std::cout << "Stalled readers keep counts? " << stalled_ok << "\n";
+    if (!counts_ok || !stalled_ok) {
+        return 1;
+    }
+
     return 0;
 }
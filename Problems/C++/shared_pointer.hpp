@@ -0,0 +1,537 @@
+#ifndef SHARED_POINTER_H
+#define SHARED_POINTER_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>      // For placement new
+#include <thread>   // For std::this_thread::yield
+#include <utility>  // For std::forward, std::swap
+#include "instrumentation.hpp"
+
+// Shared state for every SharedPtr and WeakPtr that refers to the same object.
+// Subclasses decide where the object lives and how it is destroyed.
+struct ControlBlock {
+    std::atomic<long> strong{1};
+    std::atomic<long> weak{1}; // WeakPtrs, plus one held by all SharedPtrs together
+    void* object;              // The managed object (SharedPtr never aliases)
+
+    static constexpr instrumentation::component tag = instrumentation::component::shared_pointer;
+
+    explicit ControlBlock(void* obj) : object(obj) {}
+
+    virtual void destroy_object() noexcept = 0; // Runs when the last SharedPtr goes away
+    virtual void destroy_block() noexcept = 0;  // Runs when the last WeakPtr goes away too
+    virtual ~ControlBlock() = default;
+
+    void release_weak() noexcept {
+        instrumentation::on_ref_dec(tag);
+        if (weak.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            destroy_block();
+        }
+    }
+};
+
+// Block for an object allocated separately with new (two allocations)
+template <typename T>
+struct PointerControlBlock : ControlBlock {
+    T* ptr;
+
+    explicit PointerControlBlock(T* p) : ControlBlock(p), ptr(p) {}
+
+    void destroy_object() noexcept override {
+        delete ptr;
+    }
+
+    void destroy_block() noexcept override {
+        instrumentation::on_free(tag, sizeof(*this));
+        delete this;
+    }
+};
+
+// Block with the object stored inline, used by make_shared (one allocation)
+template <typename T>
+struct InlineControlBlock : ControlBlock {
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    template <typename... Args>
+    explicit InlineControlBlock(Args&&... args) : ControlBlock(storage) {
+        new (storage) T(std::forward<Args>(args)...);
+    }
+
+    T* get() {
+        return reinterpret_cast<T*>(storage);
+    }
+
+    void destroy_object() noexcept override {
+        get()->~T();
+    }
+
+    void destroy_block() noexcept override {
+        instrumentation::on_free(tag, sizeof(*this));
+        delete this;
+    }
+};
+
+template <typename T>
+class WeakPtr;
+
+template <typename T>
+class AtomicSharedPtr;
+
+template <typename T>
+class SharedPtr {
+private:
+    T* ptr;
+    ControlBlock* ctrl;
+
+    SharedPtr(T* p, ControlBlock* block) : ptr(p), ctrl(block) {}
+
+    // Incrementing needs no ordering: the caller already holds a reference
+    void retain() {
+        if (ctrl) {
+            instrumentation::on_ref_inc(ControlBlock::tag);
+            ctrl->strong.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static ControlBlock* allocate_block(T* p) {
+        if (!p) {
+            return nullptr;
+        }
+        instrumentation::on_alloc(ControlBlock::tag, sizeof(PointerControlBlock<T>));
+        return new PointerControlBlock<T>(p);
+    }
+
+    template <typename U, typename... Args>
+    friend SharedPtr<U> make_shared(Args&&... args);
+
+    friend class WeakPtr<T>;
+    friend class AtomicSharedPtr<T>;
+
+public:
+    // Default constructor (no allocation)
+    SharedPtr() : ptr(nullptr), ctrl(nullptr) {}
+
+    // Constructor with raw pointer
+    explicit SharedPtr(T* p) : ptr(p), ctrl(allocate_block(p)) {}
+
+    // Copy constructor (increases reference count)
+    SharedPtr(const SharedPtr& other) : ptr(other.ptr), ctrl(other.ctrl) {
+        retain();
+    }
+
+    // Move constructor (steals ownership)
+    SharedPtr(SharedPtr&& other) noexcept : ptr(other.ptr), ctrl(other.ctrl) {
+        other.ptr = nullptr;
+        other.ctrl = nullptr;
+    }
+
+    // Copy assignment
+    SharedPtr& operator=(const SharedPtr& other) {
+        if (this != &other) {
+            SharedPtr(other).swap(*this);
+        }
+        return *this;
+    }
+
+    // Move assignment
+    SharedPtr& operator=(SharedPtr&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr = other.ptr;
+            ctrl = other.ctrl;
+            other.ptr = nullptr;
+            other.ctrl = nullptr;
+        }
+        return *this;
+    }
+
+    // Destructor
+    ~SharedPtr() {
+        release();
+    }
+
+    void swap(SharedPtr& other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(ctrl, other.ctrl);
+    }
+
+    // Dereference operator
+    T& operator*() const {
+        return *ptr;
+    }
+
+    // Arrow operator
+    T* operator->() const {
+        return ptr;
+    }
+
+    // Get raw pointer
+    T* get() const {
+        return ptr;
+    }
+
+    explicit operator bool() const {
+        return ptr != nullptr;
+    }
+
+    // Get reference count
+    long use_count() const {
+        return ctrl ? ctrl->strong.load(std::memory_order_relaxed) : 0;
+    }
+
+    // Drop this reference, destroying the object if it was the last one.
+    // acq_rel: the release half publishes this thread's writes to the object,
+    // the acquire half lets the destroying thread see everyone else's.
+    void release() {
+        if (ctrl) {
+            instrumentation::on_ref_dec(ControlBlock::tag);
+        }
+        if (ctrl && ctrl->strong.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            ctrl->destroy_object();
+            ctrl->release_weak();
+        }
+        ptr = nullptr;
+        ctrl = nullptr;
+    }
+
+    void reset() {
+        release();
+    }
+};
+
+// Allocates the object and its counts together
+template <typename T, typename... Args>
+SharedPtr<T> make_shared(Args&&... args) {
+    instrumentation::on_alloc(ControlBlock::tag, sizeof(InlineControlBlock<T>));
+    auto* block = new InlineControlBlock<T>(std::forward<Args>(args)...);
+    return SharedPtr<T>(block->get(), block);
+}
+
+// Non-owning reference that does not keep the object alive.
+// lock() upgrades to a SharedPtr without taking a lock: it only bumps the
+// strong count if it is still non-zero, retrying if another thread races it.
+template <typename T>
+class WeakPtr {
+private:
+    T* ptr;
+    ControlBlock* ctrl;
+
+    void retain() {
+        if (ctrl) {
+            instrumentation::on_ref_inc(ControlBlock::tag);
+            ctrl->weak.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    WeakPtr() : ptr(nullptr), ctrl(nullptr) {}
+
+    WeakPtr(const SharedPtr<T>& shared) : ptr(shared.ptr), ctrl(shared.ctrl) {
+        retain();
+    }
+
+    WeakPtr(const WeakPtr& other) : ptr(other.ptr), ctrl(other.ctrl) {
+        retain();
+    }
+
+    WeakPtr(WeakPtr&& other) noexcept : ptr(other.ptr), ctrl(other.ctrl) {
+        other.ptr = nullptr;
+        other.ctrl = nullptr;
+    }
+
+    WeakPtr& operator=(WeakPtr other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(ctrl, other.ctrl);
+        return *this;
+    }
+
+    ~WeakPtr() {
+        reset();
+    }
+
+    void reset() {
+        if (ctrl) {
+            ctrl->release_weak();
+        }
+        ptr = nullptr;
+        ctrl = nullptr;
+    }
+
+    bool expired() const {
+        return use_count() == 0;
+    }
+
+    long use_count() const {
+        return ctrl ? ctrl->strong.load(std::memory_order_relaxed) : 0;
+    }
+
+    // Empty SharedPtr if the object has already been destroyed
+    SharedPtr<T> lock() const {
+        if (!ctrl) {
+            return SharedPtr<T>();
+        }
+        long count = ctrl->strong.load(std::memory_order_relaxed);
+        while (count != 0) {
+            if (ctrl->strong.compare_exchange_weak(count, count + 1, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                instrumentation::on_ref_inc(ControlBlock::tag);
+                return SharedPtr<T>(ptr, ctrl);
+            }
+        }
+        return SharedPtr<T>();
+    }
+};
+
+// Base for objects that carry their own reference count, so IntrusivePtr
+// needs no control block and reaches the count without an extra pointer hop
+template <typename Derived>
+class RefCounted {
+private:
+    mutable std::atomic<long> refs{0};
+
+    friend void intrusive_add_ref(const RefCounted* p) {
+        instrumentation::on_ref_inc(ControlBlock::tag);
+        p->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    friend void intrusive_release(const RefCounted* p) {
+        instrumentation::on_ref_dec(ControlBlock::tag);
+        if (p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            instrumentation::on_free(ControlBlock::tag, sizeof(Derived));
+            delete static_cast<const Derived*>(p);
+        }
+    }
+
+public:
+    long ref_count() const {
+        return refs.load(std::memory_order_relaxed);
+    }
+
+protected:
+    RefCounted() = default;
+    RefCounted(const RefCounted&) {} // Copies start with their own count
+    RefCounted& operator=(const RefCounted&) { return *this; }
+    ~RefCounted() = default;
+};
+
+// Smart pointer for types that provide intrusive_add_ref/intrusive_release
+// (found by ADL), e.g. anything deriving from RefCounted
+template <typename T>
+class IntrusivePtr {
+private:
+    T* ptr;
+
+public:
+    IntrusivePtr() : ptr(nullptr) {}
+
+    explicit IntrusivePtr(T* p) : ptr(p) {
+        if (ptr) intrusive_add_ref(ptr);
+    }
+
+    IntrusivePtr(const IntrusivePtr& other) : ptr(other.ptr) {
+        if (ptr) intrusive_add_ref(ptr);
+    }
+
+    IntrusivePtr(IntrusivePtr&& other) noexcept : ptr(other.ptr) {
+        other.ptr = nullptr;
+    }
+
+    IntrusivePtr& operator=(IntrusivePtr other) noexcept {
+        std::swap(ptr, other.ptr);
+        return *this;
+    }
+
+    ~IntrusivePtr() {
+        reset();
+    }
+
+    void reset() {
+        if (ptr) intrusive_release(ptr);
+        ptr = nullptr;
+    }
+
+    T& operator*() const {
+        return *ptr;
+    }
+
+    T* operator->() const {
+        return ptr;
+    }
+
+    T* get() const {
+        return ptr;
+    }
+
+    explicit operator bool() const {
+        return ptr != nullptr;
+    }
+
+    long use_count() const {
+        return ptr ? ptr->ref_count() : 0;
+    }
+};
+
+template <typename T, typename... Args>
+IntrusivePtr<T> make_intrusive(Args&&... args) {
+    instrumentation::on_alloc(ControlBlock::tag, sizeof(T));
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+// Atomic slot holding a SharedPtr, in the spirit of std::atomic<std::shared_ptr>.
+// Uses a split reference count: the slot packs the control block pointer and
+// a "local" ticket count into one 64-bit word. A reader first bumps the
+// ticket count with a single CAS, which pins the block (a writer cannot free
+// it while the ticket is outstanding), then takes a real strong reference and
+// hands a ticket back. A writer that swaps the block out converts any
+// outstanding tickets into strong references, so late readers drop a strong
+// reference instead. Readers never block and writers never wait for readers.
+//
+// Tickets on the same block are interchangeable, which is what keeps this
+// correct when a block is published again (e.g. republishing an old
+// snapshot) while a reader is stalled: every reader still out is either
+// counted in the slot's tickets or covered by a strong reference a writer
+// added for it. So a reader may give back any ticket it finds on its block,
+// not necessarily its own, and only when the slot holds none does it know a
+// conversion covered it. No installation counter is needed, so there is
+// nothing to wrap.
+template <typename T>
+class AtomicSharedPtr {
+private:
+    static_assert(sizeof(void*) == 8, "Pointer packing assumes 48-bit user-space addresses");
+
+    // [tickets:21][pointer >> 4:43]. Blocks come from operator new, so they
+    // are 16-byte aligned and below 2^47 in user space.
+    static constexpr int ALIGN_SHIFT = 4;
+    static constexpr int TICKET_SHIFT = 43;
+    static constexpr std::uint64_t POINTER_MASK = (std::uint64_t(1) << TICKET_SHIFT) - 1;
+    static constexpr std::uint64_t TICKET_MASK = ~POINTER_MASK;
+    static constexpr std::uint64_t ONE_TICKET = std::uint64_t(1) << TICKET_SHIFT;
+    static constexpr long MAX_TICKETS = static_cast<long>(TICKET_MASK >> TICKET_SHIFT);
+
+    std::atomic<std::uint64_t> state;
+
+    static ControlBlock* block_of(std::uint64_t word) {
+        return reinterpret_cast<ControlBlock*>((word & POINTER_MASK) << ALIGN_SHIFT);
+    }
+
+    static long tickets_of(std::uint64_t word) {
+        return static_cast<long>((word & TICKET_MASK) >> TICKET_SHIFT);
+    }
+
+    // Steals desired's reference so the slot owns it
+    static std::uint64_t pack(SharedPtr<T>& desired) {
+        std::uint64_t address = reinterpret_cast<std::uint64_t>(desired.ctrl);
+        assert(address % (std::uint64_t(1) << ALIGN_SHIFT) == 0 && "control block must be 16-byte aligned");
+        assert(address >> (TICKET_SHIFT + ALIGN_SHIFT) == 0 && "control block must be below 2^47");
+        desired.ptr = nullptr;
+        desired.ctrl = nullptr;
+        return address >> ALIGN_SHIFT;
+    }
+
+    static SharedPtr<T> adopt(ControlBlock* block) {
+        return SharedPtr<T>(block ? static_cast<T*>(block->object) : nullptr, block);
+    }
+
+    // Drops the slot's reference to a block that has just been swapped out
+    static void retire(std::uint64_t old_word) {
+        ControlBlock* block = block_of(old_word);
+        if (!block) {
+            return;
+        }
+        long tickets = tickets_of(old_word);
+        if (tickets > 0) {
+            // Each reader still holding a ticket will give back a strong reference instead
+            instrumentation::on_ref_inc(ControlBlock::tag);
+            block->strong.fetch_add(tickets, std::memory_order_relaxed);
+        }
+        adopt(block).release();
+    }
+
+public:
+    AtomicSharedPtr() : state(0) {}
+
+    explicit AtomicSharedPtr(SharedPtr<T> desired) : state(pack(desired)) {}
+
+    AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+    AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+    ~AtomicSharedPtr() {
+        retire(state.load(std::memory_order_acquire));
+    }
+
+    bool is_lock_free() const {
+        return state.is_lock_free();
+    }
+
+    SharedPtr<T> load() const {
+        auto& slot = const_cast<std::atomic<std::uint64_t>&>(state);
+
+        // 1. Take a ticket on whatever block is currently published
+        std::uint64_t word = slot.load(std::memory_order_relaxed);
+        for (;;) {
+            if (!block_of(word)) {
+                return SharedPtr<T>();
+            }
+            if (tickets_of(word) == MAX_TICKETS) { // One more would overflow the word
+                std::this_thread::yield();
+                word = slot.load(std::memory_order_relaxed);
+            } else if (slot.compare_exchange_weak(word, word + ONE_TICKET, std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        ControlBlock* block = block_of(word);
+
+        // 2. The ticket keeps the block alive, so a real reference can be taken
+        instrumentation::on_ref_inc(ControlBlock::tag);
+        block->strong.fetch_add(1, std::memory_order_relaxed);
+
+        // 3. Give back a ticket on this block if the slot still has one (any
+        // will do); if not, a writer converted ours, so drop a strong reference
+        std::uint64_t current = word + ONE_TICKET;
+        while (block_of(current) == block && tickets_of(current) > 0) {
+            if (slot.compare_exchange_weak(current, current - ONE_TICKET, std::memory_order_relaxed,
+                                           std::memory_order_relaxed)) {
+                return adopt(block);
+            }
+        }
+        instrumentation::on_ref_dec(ControlBlock::tag);
+        block->strong.fetch_sub(1, std::memory_order_relaxed); // Never the last: we hold one too
+        return adopt(block);
+    }
+
+    void store(SharedPtr<T> desired) {
+        retire(state.exchange(pack(desired), std::memory_order_acq_rel));
+    }
+
+    SharedPtr<T> exchange(SharedPtr<T> desired) {
+        std::uint64_t old_word = state.exchange(pack(desired), std::memory_order_acq_rel);
+        ControlBlock* block = block_of(old_word);
+        if (block && tickets_of(old_word) > 0) {
+            instrumentation::on_ref_inc(ControlBlock::tag);
+            block->strong.fetch_add(tickets_of(old_word), std::memory_order_relaxed);
+        }
+        return adopt(block); // The slot's reference passes to the caller
+    }
+
+    // Replaces the value if it still points at expected's object; otherwise loads the current value into expected
+    bool compare_exchange_strong(SharedPtr<T>& expected, SharedPtr<T> desired) {
+        std::uint64_t word = state.load(std::memory_order_relaxed);
+        std::uint64_t desired_word = pack(desired);
+        while (block_of(word) == expected.ctrl) {
+            if (state.compare_exchange_weak(word, desired_word, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                retire(word);
+                return true;
+            }
+        }
+        retire(desired_word); // Never published: just drop the reference pack() took over
+        expected = load();
+        return false;
+    }
+};
+
+#endif
@@ -1,97 +1,5 @@
 #include <iostream>
-#include <cstring>  // For strlen, strcpy
-
-class String {
-private:
-    char* data;   // Pointer to the character array
-    std::size_t len;  // Length of the string
-
-public:
-    // Default constructor
-    String() : data(new char[1]{'\0'}), len(0) {}
-
-    // Constructor from C-string
-    String(const char* str) : len(std::strlen(str)) {
-        data = new char[len + 1];
-        std::strcpy(data, str);
-    }
-
-    // Copy constructor (deep copy)
-    String(const String& other) : len(other.len) {
-        data = new char[len + 1];
-        std::strcpy(data, other.data);
-    }
-
-    // Move constructor
-    String(String&& other) noexcept : data(other.data), len(other.len) {
-        other.data = nullptr;
-        other.len = 0;
-    }
-
-    // Copy assignment
-    String& operator=(const String& other) {
-        if (this != &other) {
-            delete[] data;
-            len = other.len;
-            data = new char[len + 1];
-            std::strcpy(data, other.data);
-        }
-        return *this;
-    }
-
-    // Move assignment
-    String& operator=(String&& other) noexcept {
-        if (this != &other) {
-            delete[] data;
-            data = other.data;
-            len = other.len;
-            other.data = nullptr;
-            other.len = 0;
-        }
-        return *this;
-    }
-
-    // Destructor
-    ~String() {
-        delete[] data;
-    }
-
-    // Get length of the string
-    std::size_t size() const {
-        return len;
-    }
-
-    // Access individual character
-    char& operator[](std::size_t index) {
-        return data[index];
-    }
-
-    const char& operator[](std::size_t index) const {
-        return data[index];
-    }
-
-    // Concatenation (operator+)
-    String operator+(const String& other) const {
-        String result;
-        result.len = len + other.len;
-        result.data = new char[result.len + 1];
-
-        std::strcpy(result.data, data);
-        std::strcat(result.data, other.data);
-
-        return result;
-    }
-
-    // Print function
-    void print() const {
-        std::cout << data << "\n";
-    }
-
-    // Get C-string
-    const char* c_str() const {
-        return data;
-    }
-};
+#include "string.hpp"
 
 int main() {
     String s1("Hello");
@@ -106,5 +14,25 @@ int main() {
     String s4 = s3;  // Copy constructor
     s4.print();
 
+    StringBuilder sb;
+    sb += s1;
+    sb += ", builder";
+    String s5 = sb.release();  // Buffer moves into the String
+    s5.print();
+
+    Rope r(s3);
+    r += "!";
+    Rope world = r.substr(6, 5);  // Shares the buffer of s3
+    (world + Rope(" of ropes")).print();
+    std::cout << "Rope size: " << r.size() << ", r[1] = " << r[1] << "\n";
+
+    SharedString id1("txn-0001");
+    SharedString id2 = id1;  // O(1), shares the buffer
+    id1.print();
+    id2.set(7, '2');  // Detaches before writing
+    id1.print();
+    id2.print();
+    std::cout << "Equal after detach? " << std::boolalpha << (id1 == id2) << "\n";
+
     return 0;
 }
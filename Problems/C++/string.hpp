@@ -0,0 +1,705 @@
+#ifndef STRING_H
+#define STRING_H
+
+#include <iostream>
+#include <cstring>  // For strlen, strcpy, memcpy
+#include <memory>   // For shared_ptr
+#include <algorithm>
+#include <atomic>
+#include <new>      // For placement new
+#include "string_kernels.hpp"
+#include "instrumentation.hpp"
+
+class StringBuilder;
+
+class String {
+private:
+    char* data;   // Pointer to the character array
+    std::size_t len;  // Length of the string
+
+    static constexpr instrumentation::component tag = instrumentation::component::string;
+
+    // Tag for the adopting constructor, so a plain char* never selects it
+    struct adopt_t {};
+
+    // Takes ownership of a new[]-allocated, null-terminated buffer
+    String(adopt_t, char* buffer, std::size_t length) : data(buffer), len(length) {}
+
+    friend class StringBuilder;
+
+    static char* allocate(std::size_t bytes) {
+        instrumentation::on_alloc(tag, bytes);
+        return new char[bytes];
+    }
+
+    // Buffers adopted from a StringBuilder may be larger than len + 1,
+    // so bytes_freed can undercount them
+    void release_data() {
+        if (data) {
+            instrumentation::on_free(tag, len + 1);
+        }
+        delete[] data;
+    }
+
+public:
+    // Default constructor
+    String() : data(allocate(1)), len(0) {
+        data[0] = '\0';
+    }
+
+    // Constructor from C-string
+    String(const char* str) : len(std::strlen(str)) {
+        data = allocate(len + 1);
+        std::memcpy(data, str, len + 1);
+        instrumentation::on_copy(tag, len);
+    }
+
+    // Constructor from a buffer of known length
+    String(const char* str, std::size_t length) : len(length) {
+        data = allocate(len + 1);
+        std::memcpy(data, str, len);
+        data[len] = '\0';
+        instrumentation::on_copy(tag, len);
+    }
+
+    // Copy constructor (deep copy)
+    String(const String& other) : len(other.len) {
+        data = allocate(len + 1);
+        std::memcpy(data, other.data, len + 1);
+        instrumentation::on_copy(tag, len);
+    }
+
+    // Move constructor
+    String(String&& other) noexcept : data(other.data), len(other.len) {
+        other.data = nullptr;
+        other.len = 0;
+    }
+
+    // Copy assignment
+    String& operator=(const String& other) {
+        if (this != &other) {
+            release_data();
+            len = other.len;
+            data = allocate(len + 1);
+            std::memcpy(data, other.data, len + 1);
+            instrumentation::on_copy(tag, len);
+        }
+        return *this;
+    }
+
+    // Move assignment
+    String& operator=(String&& other) noexcept {
+        if (this != &other) {
+            release_data();
+            data = other.data;
+            len = other.len;
+            other.data = nullptr;
+            other.len = 0;
+        }
+        return *this;
+    }
+
+    // Destructor
+    ~String() {
+        release_data();
+    }
+
+    // Get length of the string
+    std::size_t size() const {
+        return len;
+    }
+
+    // Access individual character
+    char& operator[](std::size_t index) {
+        return data[index];
+    }
+
+    const char& operator[](std::size_t index) const {
+        return data[index];
+    }
+
+    // Concatenation (operator+)
+    String operator+(const String& other) const {
+        std::size_t total = len + other.len;
+        char* buffer = allocate(total + 1);
+
+        std::memcpy(buffer, data, len);
+        std::memcpy(buffer + len, other.data, other.len + 1);
+        instrumentation::on_copy(tag, total);
+
+        return String(adopt_t{}, buffer, total);
+    }
+
+    // Search, comparison and hashing (vectorised, see string_kernels.hpp)
+    static constexpr std::size_t npos = string_kernels::npos;
+
+    std::size_t find(const String& needle, std::size_t pos = 0) const {
+        return string_kernels::find(c_str(), size(), needle.c_str(), needle.size(), pos);
+    }
+
+    int compare(const String& other) const {
+        return string_kernels::compare(c_str(), size(), other.c_str(), other.size());
+    }
+
+    bool starts_with(const String& prefix) const {
+        return string_kernels::starts_with(c_str(), size(), prefix.c_str(), prefix.size());
+    }
+
+    std::size_t hash() const {
+        return string_kernels::hash(c_str(), size());
+    }
+
+    // Length is checked first, so strings of different sizes compare in O(1)
+    bool operator==(const String& other) const {
+        return string_kernels::equal(c_str(), size(), other.c_str(), other.size());
+    }
+
+    bool operator!=(const String& other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const String& other) const {
+        return compare(other) < 0;
+    }
+
+    // Print function
+    void print() const {
+        std::cout << data << "\n";
+    }
+
+    // Get C-string
+    const char* c_str() const {
+        return data;
+    }
+};
+
+// Growable char buffer with amortised O(1) appends.
+// release() hands the buffer to a String without copying it.
+class StringBuilder {
+private:
+    char* buffer;     // Null-terminated once anything is appended
+    std::size_t len;  // Number of chars written
+    std::size_t cap;  // Chars that fit before reallocating (excluding '\0')
+
+    // Moves the contents into a bigger buffer and appends `length` bytes of
+    // str there. The old buffer is freed only afterwards, so str may point into it.
+    void grow(std::size_t min_capacity, const char* str, std::size_t length) {
+        std::size_t new_capacity = std::max(min_capacity, cap == 0 ? 16 : cap * 2);
+        char* new_buffer = String::allocate(new_capacity + 1);
+        if (buffer) {
+            std::memcpy(new_buffer, buffer, len);
+            instrumentation::on_growth(String::tag);
+            instrumentation::on_move(String::tag, len);
+        }
+        std::memcpy(new_buffer + len, str, length);
+        instrumentation::on_copy(String::tag, length);
+        new_buffer[len + length] = '\0';
+        free_buffer();
+        buffer = new_buffer;
+        len += length;
+        cap = new_capacity;
+    }
+
+    void free_buffer() {
+        if (buffer) {
+            instrumentation::on_free(String::tag, cap + 1);
+        }
+        delete[] buffer;
+    }
+
+public:
+    StringBuilder() : buffer(nullptr), len(0), cap(0) {}
+
+    StringBuilder(const StringBuilder& other) : buffer(nullptr), len(0), cap(0) {
+        append(other.c_str(), other.len);
+    }
+
+    StringBuilder(StringBuilder&& other) noexcept : buffer(other.buffer), len(other.len), cap(other.cap) {
+        other.buffer = nullptr;
+        other.len = 0;
+        other.cap = 0;
+    }
+
+    StringBuilder& operator=(StringBuilder other) noexcept {
+        std::swap(buffer, other.buffer);
+        std::swap(len, other.len);
+        std::swap(cap, other.cap);
+        return *this;
+    }
+
+    ~StringBuilder() {
+        free_buffer();
+    }
+
+    std::size_t size() const {
+        return len;
+    }
+
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity > cap) {
+            grow(new_capacity, "", 0);
+        }
+    }
+
+    StringBuilder& append(const char* str, std::size_t length) {
+        if (length == 0) {
+            return *this;
+        }
+        if (len + length > cap) {
+            grow(len + length, str, length);
+            return *this;
+        }
+        std::memcpy(buffer + len, str, length);
+        instrumentation::on_copy(String::tag, length);
+        len += length;
+        buffer[len] = '\0';
+        return *this;
+    }
+
+    StringBuilder& append(const char* str) {
+        return append(str, std::strlen(str));
+    }
+
+    StringBuilder& append(const String& str) {
+        return append(str.c_str(), str.size());
+    }
+
+    template <typename S>
+    StringBuilder& operator+=(const S& str) {
+        return append(str);
+    }
+
+    const char* c_str() const {
+        return buffer ? buffer : "";
+    }
+
+    // Copy the contents out, leaving the builder usable
+    String str() const {
+        return String(c_str(), len);
+    }
+
+    // Move the buffer into a String and reset the builder
+    String release() {
+        if (!buffer) {
+            return String();
+        }
+        String result(String::adopt_t{}, buffer, len);
+        buffer = nullptr;
+        len = 0;
+        cap = 0;
+        return result;
+    }
+};
+
+// Immutable-leaf rope: a height-balanced tree of slices into shared Strings.
+// Small appends collect in a tail builder and are sealed into a leaf every
+// CHUNK_SIZE bytes, so appends are amortised O(1). Concatenating ropes and
+// taking substrings share existing leaves instead of copying bytes. The
+// tree is only flattened into one buffer when c_str() asks for it.
+//
+// Not thread-safe, even for const access: c_str(), operator[], substr(),
+// str(), depth(), operator+ and append(const Rope&) (on the argument) seal
+// the tail, and c_str() flattens the tree in place. Threads that share a
+// Rope need external locking, or copies made up front (cheap: the leaves
+// are immutable and shared, so separate copies never race).
+class Rope {
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        std::size_t length;
+        int height;                         // 0 for leaves
+        std::shared_ptr<const String> text; // Leaves only
+        std::size_t offset;                 // Leaves only: start of the slice in text
+        NodePtr left;                       // Concat nodes only
+        NodePtr right;
+    };
+
+    static constexpr std::size_t CHUNK_SIZE = 1024;
+
+    // Both are mutable so that c_str() can seal and flatten lazily (see above)
+    mutable NodePtr root;
+    mutable StringBuilder tail;
+
+    static int height(const NodePtr& node) {
+        return node ? node->height : -1;
+    }
+
+    static NodePtr make_leaf(std::shared_ptr<const String> text, std::size_t offset, std::size_t length) {
+        return std::make_shared<const Node>(Node{length, 0, std::move(text), offset, nullptr, nullptr});
+    }
+
+    static NodePtr make_concat(NodePtr left, NodePtr right) {
+        std::size_t length = left->length + right->length;
+        int h = 1 + std::max(left->height, right->height);
+        return std::make_shared<const Node>(Node{length, h, nullptr, 0, std::move(left), std::move(right)});
+    }
+
+    // AVL-style join: descend the taller side and rotate on the way back up,
+    // so the result stays balanced and only O(log n) nodes are created
+    static NodePtr join(const NodePtr& left, const NodePtr& right) {
+        if (!left) return right;
+        if (!right) return left;
+
+        if (left->height > right->height + 1) {
+            NodePtr t = join(left->right, right);
+            if (t->height <= left->left->height + 1) {
+                return make_concat(left->left, t);
+            }
+            if (t->right->height >= t->left->height) {
+                return make_concat(make_concat(left->left, t->left), t->right);
+            }
+            return make_concat(make_concat(left->left, t->left->left),
+                               make_concat(t->left->right, t->right));
+        }
+
+        if (right->height > left->height + 1) {
+            NodePtr t = join(left, right->left);
+            if (t->height <= right->right->height + 1) {
+                return make_concat(t, right->right);
+            }
+            if (t->left->height >= t->right->height) {
+                return make_concat(t->left, make_concat(t->right, right->right));
+            }
+            return make_concat(make_concat(t->left, t->right->left),
+                               make_concat(t->right->right, right->right));
+        }
+
+        return make_concat(left, right);
+    }
+
+    static NodePtr slice(const NodePtr& node, std::size_t pos, std::size_t length) {
+        if (length == 0) {
+            return nullptr;
+        }
+        if (pos == 0 && length == node->length) {
+            return node;
+        }
+        if (node->height == 0) {
+            return make_leaf(node->text, node->offset + pos, length);
+        }
+        std::size_t left_length = node->left->length;
+        if (pos + length <= left_length) {
+            return slice(node->left, pos, length);
+        }
+        if (pos >= left_length) {
+            return slice(node->right, pos - left_length, length);
+        }
+        return join(slice(node->left, pos, left_length - pos),
+                    slice(node->right, 0, pos + length - left_length));
+    }
+
+    static void copy_leaves(const NodePtr& node, StringBuilder& out) {
+        if (!node) {
+            return;
+        }
+        if (node->height == 0) {
+            out.append(node->text->c_str() + node->offset, node->length);
+            return;
+        }
+        copy_leaves(node->left, out);
+        copy_leaves(node->right, out);
+    }
+
+    void seal_tail() const {
+        if (tail.size() > 0) {
+            auto text = std::make_shared<const String>(tail.release());
+            root = join(root, make_leaf(text, 0, text->size()));
+        }
+    }
+
+    bool is_flat() const {
+        return root && root->height == 0 && root->offset == 0 && root->length == root->text->size();
+    }
+
+public:
+    Rope() = default;
+
+    Rope(const String& str) {
+        append(str);
+    }
+
+    std::size_t size() const {
+        return (root ? root->length : 0) + tail.size();
+    }
+
+    Rope& append(const char* str, std::size_t length) {
+        if (length < CHUNK_SIZE) {
+            tail.append(str, length);
+            if (tail.size() >= CHUNK_SIZE) {
+                seal_tail();
+            }
+        } else {
+            seal_tail();
+            auto text = std::make_shared<const String>(str, length);
+            root = join(root, make_leaf(text, 0, length));
+        }
+        return *this;
+    }
+
+    Rope& append(const char* str) {
+        return append(str, std::strlen(str));
+    }
+
+    Rope& append(const String& str) {
+        return append(str.c_str(), str.size());
+    }
+
+    // Shares the other rope's leaves; no bytes are copied
+    Rope& append(const Rope& other) {
+        seal_tail();
+        other.seal_tail();
+        root = join(root, other.root);
+        return *this;
+    }
+
+    template <typename S>
+    Rope& operator+=(const S& str) {
+        return append(str);
+    }
+
+    Rope operator+(const Rope& other) const {
+        Rope result(*this);
+        result.append(other);
+        return result;
+    }
+
+    // Substring view sharing the underlying buffers
+    Rope substr(std::size_t pos, std::size_t length) const {
+        seal_tail();
+        Rope result;
+        if (pos < size()) {
+            result.root = slice(root, pos, std::min(length, size() - pos));
+        }
+        return result;
+    }
+
+    char operator[](std::size_t index) const {
+        seal_tail();
+        const Node* node = root.get();
+        while (node->height > 0) {
+            if (index < node->left->length) {
+                node = node->left.get();
+            } else {
+                index -= node->left->length;
+                node = node->right.get();
+            }
+        }
+        return (*node->text)[node->offset + index];
+    }
+
+    // Flattens into a single buffer on first use; later calls are free
+    const char* c_str() const {
+        seal_tail();
+        if (!root) {
+            return "";
+        }
+        if (!is_flat()) {
+            StringBuilder out;
+            out.reserve(root->length);
+            copy_leaves(root, out);
+            auto text = std::make_shared<const String>(out.release());
+            root = make_leaf(text, 0, text->size());
+        }
+        return root->text->c_str();
+    }
+
+    String str() const {
+        return String(c_str(), size());
+    }
+
+    // Tree height, for seeing how balanced the rope is
+    int depth() const {
+        seal_tail();
+        return height(root) + 1;
+    }
+
+    void print() const {
+        std::cout << c_str() << "\n";
+    }
+};
+
+// Immutable, reference-counted string with copy-on-write mutation.
+// The count, length, cached hash and characters share one allocation:
+//   [refs][len][hash][chars...'\0']
+// Copies only bump the count. set()/append() detach first when the
+// buffer is shared, so each thread mutating its own copy is safe.
+class SharedString {
+private:
+    struct Header {
+        std::atomic<std::size_t> refs;
+        std::size_t len;
+        std::size_t hash;
+
+        char* chars() {
+            return reinterpret_cast<char*>(this + 1);
+        }
+    };
+
+    Header* rep; // nullptr for the empty string, so default construction never allocates
+
+    static constexpr instrumentation::component tag = instrumentation::component::shared_string;
+
+    static std::size_t compute_hash(const char* str, std::size_t length) {
+        return string_kernels::hash(str, length);
+    }
+
+    // Allocates a block for `capacity` chars and copies `length` of them from str
+    static Header* allocate(const char* str, std::size_t length, std::size_t capacity) {
+        void* block = ::operator new(sizeof(Header) + capacity + 1);
+        instrumentation::on_alloc(tag, sizeof(Header) + capacity + 1);
+        Header* header = new (block) Header{{1}, length, 0};
+        std::memcpy(header->chars(), str, length);
+        instrumentation::on_copy(tag, length);
+        header->chars()[length] = '\0';
+        header->hash = compute_hash(str, length);
+        return header;
+    }
+
+    // Blocks are always allocated with capacity == len
+    void release() {
+        if (!rep) {
+            return;
+        }
+        instrumentation::on_ref_dec(tag);
+        // acq_rel so the last owner sees every write made through other copies
+        if (rep->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            instrumentation::on_free(tag, sizeof(Header) + rep->len + 1);
+            rep->~Header();
+            ::operator delete(rep);
+        }
+        rep = nullptr;
+    }
+
+    static void add_ref(Header* header) {
+        if (header) {
+            instrumentation::on_ref_inc(tag);
+            header->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Make sure this object is the only owner before writing
+    void detach() {
+        if (rep && rep->refs.load(std::memory_order_acquire) == 1) {
+            return;
+        }
+        Header* copy = allocate(c_str(), size(), size());
+        release();
+        rep = copy;
+    }
+
+public:
+    SharedString() : rep(nullptr) {}
+
+    SharedString(const char* str) : SharedString(str, std::strlen(str)) {}
+
+    SharedString(const char* str, std::size_t length) : rep(length ? allocate(str, length, length) : nullptr) {}
+
+    explicit SharedString(const String& str) : SharedString(str.c_str(), str.size()) {}
+
+    // Copy constructor (O(1), shares the buffer)
+    SharedString(const SharedString& other) : rep(other.rep) {
+        add_ref(rep);
+    }
+
+    SharedString(SharedString&& other) noexcept : rep(other.rep) {
+        other.rep = nullptr;
+    }
+
+    SharedString& operator=(const SharedString& other) {
+        if (rep != other.rep) {
+            add_ref(other.rep);
+            release();
+            rep = other.rep;
+        }
+        return *this;
+    }
+
+    SharedString& operator=(SharedString&& other) noexcept {
+        if (this != &other) {
+            release();
+            rep = other.rep;
+            other.rep = nullptr;
+        }
+        return *this;
+    }
+
+    ~SharedString() {
+        release();
+    }
+
+    std::size_t size() const {
+        return rep ? rep->len : 0;
+    }
+
+    const char* c_str() const {
+        return rep ? rep->chars() : "";
+    }
+
+    const char& operator[](std::size_t index) const {
+        return c_str()[index];
+    }
+
+    // Computed once per buffer, so hashing a copy is free
+    std::size_t hash() const {
+        return rep ? rep->hash : compute_hash("", 0);
+    }
+
+    std::size_t use_count() const {
+        return rep ? rep->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    // Same buffer or different length/hash short-circuits before comparing bytes
+    bool operator==(const SharedString& other) const {
+        if (rep == other.rep) return true;
+        if (size() != other.size() || hash() != other.hash()) return false;
+        return std::memcmp(c_str(), other.c_str(), size()) == 0;
+    }
+
+    bool operator!=(const SharedString& other) const {
+        return !(*this == other);
+    }
+
+    // Copy-on-write mutation
+    void set(std::size_t index, char ch) {
+        detach();
+        rep->chars()[index] = ch;
+        rep->hash = compute_hash(rep->chars(), rep->len);
+    }
+
+    SharedString& append(const char* str, std::size_t length) {
+        if (length == 0) {
+            return *this;
+        }
+        Header* grown = allocate(c_str(), size(), size() + length);
+        std::memcpy(grown->chars() + grown->len, str, length);
+        instrumentation::on_copy(tag, length);
+        grown->len += length;
+        grown->chars()[grown->len] = '\0';
+        grown->hash = compute_hash(grown->chars(), grown->len);
+        release();
+        rep = grown;
+        return *this;
+    }
+
+    SharedString& operator+=(const SharedString& other) {
+        return append(other.c_str(), other.size());
+    }
+
+    String str() const {
+        return String(c_str(), size());
+    }
+
+    void print() const {
+        std::cout << c_str() << " (refs: " << use_count() << ")\n";
+    }
+};
+
+struct SharedStringHash {
+    std::size_t operator()(const SharedString& str) const {
+        return str.hash();
+    }
+};
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef STRING_KERNELS_H
+#define STRING_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define STRING_KERNELS_X86 1
+#endif
+
+// Search, comparison and hashing helpers shared by the String classes.
+// Search and hashing have a scalar kernel plus SSE4.2 and AVX2 versions
+// compiled with per-function target attributes; the best one the CPU
+// supports is picked once at startup. All tiers return identical results,
+// including the hash, which is CRC32C in both hardware and software form.
+namespace string_kernels {
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// ---------------------------------------------------------------- scalar
+
+inline std::size_t find_scalar(const char* hay, std::size_t hay_len, const char* needle, std::size_t needle_len) {
+    if (needle_len == 0) return 0;
+    if (needle_len > hay_len) return npos;
+    for (std::size_t i = 0; i + needle_len <= hay_len; ++i) {
+        if (hay[i] == needle[0] && std::memcmp(hay + i, needle, needle_len) == 0) return i;
+    }
+    return npos;
+}
+
+struct crc32c_table {
+    std::uint32_t entries[256];
+
+    constexpr crc32c_table() : entries() {
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+inline std::size_t finish_hash(std::uint32_t crc, std::size_t len) {
+    return (static_cast<std::uint64_t>(len) << 32) | static_cast<std::uint32_t>(~crc);
+}
+
+inline std::size_t hash_scalar(const char* str, std::size_t len) {
+    static constexpr crc32c_table table;
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < len; ++i) {
+        crc = table.entries[(crc ^ static_cast<unsigned char>(str[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return finish_hash(crc, len);
+}
+
+#ifdef STRING_KERNELS_X86
+
+// ---------------------------------------------------------------- SSE4.2
+
+// Compares the first and last needle chars at 16 candidate positions at once,
+// then verifies only the candidates where both match
+__attribute__((target("sse4.2")))
+inline std::size_t find_sse42(const char* hay, std::size_t hay_len, const char* needle, std::size_t needle_len) {
+    if (needle_len == 0) return 0;
+    if (needle_len > hay_len) return npos;
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+    std::size_t i = 0;
+    for (; i + needle_len + 15 <= hay_len; i += 16) {
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+        __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + needle_len - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+        while (mask) {
+            unsigned bit = __builtin_ctz(mask);
+            if (needle_len <= 2 || std::memcmp(hay + i + bit + 1, needle + 1, needle_len - 2) == 0) {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+    std::size_t rest = find_scalar(hay + i, hay_len - i, needle, needle_len);
+    return rest == npos ? npos : i + rest;
+}
+
+__attribute__((target("sse4.2")))
+inline std::size_t hash_sse42(const char* str, std::size_t len) {
+    std::uint64_t crc = 0xFFFFFFFFu;
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, str + i, 8);
+        crc = _mm_crc32_u64(crc, chunk);
+    }
+    std::uint32_t crc32 = static_cast<std::uint32_t>(crc);
+    for (; i < len; ++i) {
+        crc32 = _mm_crc32_u8(crc32, static_cast<unsigned char>(str[i]));
+    }
+    return finish_hash(crc32, len);
+}
+
+// ---------------------------------------------------------------- AVX2
+
+__attribute__((target("avx2")))
+inline std::size_t find_avx2(const char* hay, std::size_t hay_len, const char* needle, std::size_t needle_len) {
+    if (needle_len == 0) return 0;
+    if (needle_len > hay_len) return npos;
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+    std::size_t i = 0;
+    for (; i + needle_len + 31 <= hay_len; i += 32) {
+        __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+        __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + needle_len - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+        while (mask) {
+            unsigned bit = __builtin_ctz(mask);
+            if (needle_len <= 2 || std::memcmp(hay + i + bit + 1, needle + 1, needle_len - 2) == 0) {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+    std::size_t rest = find_sse42(hay + i, hay_len - i, needle, needle_len);
+    return rest == npos ? npos : i + rest;
+}
+
+#endif // STRING_KERNELS_X86
+
+// ---------------------------------------------------------------- dispatch
+
+struct kernel_table {
+    const char* isa;
+    std::size_t (*find)(const char*, std::size_t, const char*, std::size_t);
+    std::size_t (*hash)(const char*, std::size_t);
+};
+
+inline kernel_table select_kernels() {
+#ifdef STRING_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2")) {
+        return {"avx2", find_avx2, hash_sse42};
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return {"sse4.2", find_sse42, hash_sse42};
+    }
+#endif
+    return {"scalar", find_scalar, hash_scalar};
+}
+
+inline const kernel_table& kernels() {
+    static const kernel_table table = select_kernels();
+    return table;
+}
+
+inline const char* active_isa() {
+    return kernels().isa;
+}
+
+// Equality, ordering and prefix tests go straight to memcmp: libc already
+// dispatches it to an AVX2/EVEX version and the compiler inlines it for
+// constant sizes, so a table-dispatched mismatch kernel lost to it at every
+// length in bench_string_sso. The table only covers find and hash, where
+// libc has nothing equivalent.
+
+// Lengths are compared first, so unequal strings never touch their bytes
+inline bool equal(const char* a, std::size_t a_len, const char* b, std::size_t b_len) {
+    return a_len == b_len && (a == b || std::memcmp(a, b, a_len) == 0);
+}
+
+// <0, 0 or >0 like strcmp, but length-aware and safe with embedded '\0'
+inline int compare(const char* a, std::size_t a_len, const char* b, std::size_t b_len) {
+    std::size_t n = a_len < b_len ? a_len : b_len;
+    int order = std::memcmp(a, b, n);
+    if (order != 0) {
+        return order < 0 ? -1 : 1;
+    }
+    return a_len < b_len ? -1 : (a_len > b_len ? 1 : 0);
+}
+
+inline bool starts_with(const char* str, std::size_t len, const char* prefix, std::size_t prefix_len) {
+    return prefix_len <= len && std::memcmp(str, prefix, prefix_len) == 0;
+}
+
+// Position of the first occurrence of needle at or after pos, or npos
+inline std::size_t find(const char* hay, std::size_t hay_len, const char* needle, std::size_t needle_len, std::size_t pos = 0) {
+    if (pos > hay_len) return npos;
+    std::size_t found = kernels().find(hay + pos, hay_len - pos, needle, needle_len);
+    return found == npos ? npos : pos + found;
+}
+
+inline std::size_t hash(const char* str, std::size_t len) {
+    return kernels().hash(str, len);
+}
+
+} // namespace string_kernels
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef STRING_SSO_H
+#define STRING_SSO_H
+
+#include <iostream>
+#include <cstring>  // For strlen, memcpy
+#include "string_kernels.hpp"
+#include "instrumentation.hpp"
+
+// 24-byte string laid out like libc++'s std::string (little-endian layout).
+// The lowest bit of the first byte tells the two representations apart:
+//   short: [size << 1 | 0][22 chars + '\0']
+//   long:  [capacity | 1 ][size][heap pointer]
+// Heap allocations are always an even number of bytes, so the flag bit
+// of the stored allocation size is free to mark the long form.
+class String {
+private:
+    struct Long {
+        std::size_t cap;   // Allocated bytes (even) with the long flag in bit 0
+        std::size_t len;   // Length of heap-allocated string
+        char* heap_data;   // Pointer for dynamically allocated memory
+    };
+
+    static constexpr std::size_t SSO_CAPACITY = sizeof(Long) - 2; // 22 chars + size byte + '\0'
+
+    struct Short {
+        unsigned char size;              // size << 1, bit 0 is always clear
+        char buffer[SSO_CAPACITY + 1];   // Inline buffer for short strings
+    };
+
+    static_assert(sizeof(Short) == sizeof(Long), "Short and long forms must overlap exactly");
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Flag bit must be in the first byte");
+
+    static constexpr std::size_t LONG_FLAG = 1;
+
+    static constexpr instrumentation::component tag = instrumentation::component::string_sso;
+
+    union {
+        Long l;
+        Short s;
+    };
+
+    bool is_long() const {
+        return s.size & LONG_FLAG;
+    }
+
+    char* get_pointer() {
+        return is_long() ? l.heap_data : s.buffer;
+    }
+
+    const char* get_pointer() const {
+        return is_long() ? l.heap_data : s.buffer;
+    }
+
+    void set_size(std::size_t length) {
+        if (is_long()) {
+            l.len = length;
+        } else {
+            s.size = static_cast<unsigned char>(length << 1);
+        }
+    }
+
+    void init_short() {
+        s.size = 0;
+        s.buffer[0] = '\0';
+    }
+
+    // Sets up storage for at least `capacity` chars and copies `length` bytes of str
+    void init(const char* str, std::size_t length, std::size_t capacity) {
+        if (capacity <= SSO_CAPACITY) {
+            s.size = static_cast<unsigned char>(length << 1);
+            std::memcpy(s.buffer, str, length);
+            s.buffer[length] = '\0';
+        } else {
+            std::size_t alloc = (capacity + 2) & ~LONG_FLAG; // Room for '\0', rounded up to even
+            instrumentation::on_alloc(tag, alloc);
+            l.heap_data = new char[alloc];
+            l.cap = alloc | LONG_FLAG;
+            l.len = length;
+            std::memcpy(l.heap_data, str, length);
+            l.heap_data[length] = '\0';
+        }
+    }
+
+    void release_heap() {
+        if (is_long()) {
+            instrumentation::on_free(tag, l.cap & ~LONG_FLAG);
+            delete[] l.heap_data;
+        }
+    }
+
+    // Construction counts as a placement; growth and reuse do not
+    void init_copy(const char* str, std::size_t length) {
+        init(str, length, length);
+        instrumentation::on_placement(tag, !is_long());
+        instrumentation::on_copy(tag, length);
+    }
+
+    // Moves the contents into a buffer of new_capacity and appends `length`
+    // bytes of str there. The old buffer is released only afterwards, so str
+    // may point into this string.
+    void regrow(std::size_t new_capacity, const char* str, std::size_t length) {
+        std::size_t old_size = size();
+        String grown;
+        grown.init(get_pointer(), old_size, new_capacity);
+        std::memcpy(grown.get_pointer() + old_size, str, length);
+        grown.get_pointer()[old_size + length] = '\0';
+        grown.set_size(old_size + length);
+        instrumentation::on_growth(tag);
+        instrumentation::on_move(tag, old_size);
+        instrumentation::on_copy(tag, length);
+        *this = std::move(grown);
+    }
+
+    void steal(String& other) noexcept {
+        std::memcpy(static_cast<void*>(this), &other, sizeof(String));
+        other.init_short();
+    }
+
+public:
+    // Default constructor
+    String() {
+        init_short();
+    }
+
+    // Constructor from C-string
+    String(const char* str) {
+        init_copy(str, std::strlen(str));
+    }
+
+    // Constructor from a buffer of known length
+    String(const char* str, std::size_t length) {
+        init_copy(str, length);
+    }
+
+    // Copy constructor (short strings are a 24-byte memcpy)
+    String(const String& other) {
+        if (other.is_long()) {
+            init_copy(other.l.heap_data, other.l.len);
+        } else {
+            std::memcpy(static_cast<void*>(this), &other, sizeof(String));
+            instrumentation::on_placement(tag, true);
+            instrumentation::on_copy(tag, other.size());
+        }
+    }
+
+    // Move constructor
+    String(String&& other) noexcept {
+        steal(other);
+    }
+
+    // Copy assignment (reuses the existing heap buffer when it is big enough)
+    String& operator=(const String& other) {
+        if (this != &other) {
+            std::size_t length = other.size();
+            if (length <= capacity()) {
+                std::memcpy(get_pointer(), other.get_pointer(), length + 1);
+                set_size(length);
+                instrumentation::on_copy(tag, length);
+            } else {
+                release_heap();
+                init_copy(other.get_pointer(), length);
+            }
+        }
+        return *this;
+    }
+
+    // Move assignment
+    String& operator=(String&& other) noexcept {
+        if (this != &other) {
+            release_heap();
+            steal(other);
+        }
+        return *this;
+    }
+
+    // Destructor
+    ~String() {
+        release_heap();
+    }
+
+    // Get string length in O(1)
+    std::size_t size() const {
+        return is_long() ? l.len : s.size >> 1;
+    }
+
+    // Number of chars that fit without reallocating
+    std::size_t capacity() const {
+        return is_long() ? (l.cap & ~LONG_FLAG) - 1 : SSO_CAPACITY;
+    }
+
+    bool is_sso() const {
+        return !is_long();
+    }
+
+    // Grow storage to hold at least new_capacity chars
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity <= capacity()) {
+            return;
+        }
+        regrow(new_capacity, "", 0);
+    }
+
+    // Append with amortised doubling, so repeated appends are linear overall
+    String& append(const char* str, std::size_t length) {
+        std::size_t old_size = size();
+        std::size_t new_size = old_size + length;
+        if (new_size > capacity()) {
+            std::size_t doubled = 2 * capacity();
+            regrow(new_size > doubled ? new_size : doubled, str, length);
+            return *this;
+        }
+        char* p = get_pointer();
+        std::memmove(p + old_size, str, length); // str may point into this string
+        instrumentation::on_copy(tag, length);
+        p[new_size] = '\0';
+        set_size(new_size);
+        return *this;
+    }
+
+    String& append(const String& other) {
+        return append(other.get_pointer(), other.size());
+    }
+
+    String& operator+=(const String& other) {
+        return append(other);
+    }
+
+    String& operator+=(const char* str) {
+        return append(str, std::strlen(str));
+    }
+
+    // Access character by index
+    char& operator[](std::size_t index) {
+        return get_pointer()[index];
+    }
+
+    const char& operator[](std::size_t index) const {
+        return get_pointer()[index];
+    }
+
+    // Concatenation (one allocation at most, sized for both operands)
+    String operator+(const String& other) const {
+        String result;
+        result.reserve(size() + other.size());
+        result.append(*this);
+        result.append(other);
+        return result;
+    }
+
+    // Get C-string
+    const char* c_str() const {
+        return get_pointer();
+    }
+
+    // Search, comparison and hashing (vectorised, see string_kernels.hpp)
+    static constexpr std::size_t npos = string_kernels::npos;
+
+    std::size_t find(const String& needle, std::size_t pos = 0) const {
+        return string_kernels::find(c_str(), size(), needle.c_str(), needle.size(), pos);
+    }
+
+    int compare(const String& other) const {
+        return string_kernels::compare(c_str(), size(), other.c_str(), other.size());
+    }
+
+    bool starts_with(const String& prefix) const {
+        return string_kernels::starts_with(c_str(), size(), prefix.c_str(), prefix.size());
+    }
+
+    std::size_t hash() const {
+        return string_kernels::hash(c_str(), size());
+    }
+
+    // Length is checked first, so strings of different sizes compare in O(1)
+    bool operator==(const String& other) const {
+        return string_kernels::equal(c_str(), size(), other.c_str(), other.size());
+    }
+
+    bool operator!=(const String& other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const String& other) const {
+        return compare(other) < 0;
+    }
+
+    // Print function for debugging
+    void print() const {
+        std::cout << c_str() << " (size: " << size() << ", capacity: " << capacity() << ", "
+                  << (is_sso() ? "SSO" : "Heap") << ")\n";
+    }
+};
+
+static_assert(sizeof(String) == 24, "String should stay three words wide");
+
+#endif
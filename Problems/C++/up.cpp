@@ -1,72 +1,23 @@
 #include<iostream>
+#include "up.hpp"
 
 struct foo {
     int a;
     bool b;
 };
 
-template<typename T>
-class unique_pointer {
-public:
-    constexpr unique_pointer() : ptr{nullptr} {}
+struct counting_delete {
+    static inline int calls = 0;
 
-    unique_pointer(T* _ptr) : ptr{_ptr} {}
-
-    // copy constructor
-    unique_pointer(const unique_pointer<T> &other) = delete;
-
-    // move constructor
-    unique_pointer(unique_pointer<T> &&other) : ptr{other.ptr} {
-        other.ptr = nullptr;
-    }
-
-    // assignment
-    unique_pointer& operator= (const T* other) noexcept {
-        delete ptr;
-        ptr = other;
-        return *this;
-    }
-
-    // copy assignment 
-    void operator= (const unique_pointer<T> &other) = delete;
-
-    // move assignment 
-    unique_pointer& operator= (unique_pointer<T> &&other) {
-        if (ptr) delete ptr;
-        ptr = other.ptr;
-        other.ptr = nullptr;
-        return *this;
-    }
-
-    ~unique_pointer() {
+    void operator() (foo* ptr) const noexcept {
+        ++calls;
         delete ptr;
     }
-
-    T* get() const noexcept {
-        return ptr;
-    }
-
-    T& operator* () const noexcept { 
-        return *ptr; 
-    }
-
-    T* operator-> () const noexcept { 
-        return ptr; 
-    }
-
-    explicit operator bool () const noexcept { 
-        return ptr != nullptr; 
-    }
-
-private:
-    T* ptr;
 };
 
-template<typename T, typename U,
-    typename = std::enable_if_t<std::is_convertible_v<T*, U*> || std::is_convertible_v<U*, T*> > >
-bool operator== (const unique_pointer<T>& first, const unique_pointer<U>& second) noexcept {
-    return first.get() == second.get();
-}
+static_assert(sizeof(unique_pointer<foo>) == sizeof(foo*), "default deleter must be free");
+static_assert(sizeof(unique_pointer<foo[]>) == sizeof(foo*), "array deleter must be free");
+static_assert(sizeof(unique_pointer<foo, counting_delete>) == sizeof(foo*), "stateless deleters must be free");
 
 int main() {
     unique_pointer<foo> u(new foo{5, true});
@@ -79,6 +30,29 @@ int main() {
     std::cout << u_copy.a << " " << u_copy.b << std::endl;
     std::cout << ua << " " << ub << std::endl;
 
-    unique_pointer<foo> u_array = new foo[10];
-    u_array[0].a = 
-}
\ No newline at end of file
+    unique_pointer<foo[]> u_array = new foo[10];
+    u_array[0].a = 7;
+    u_array[9].a = 9;
+    std::cout << u_array[0].a << " " << u_array[9].a << std::endl;
+
+    {
+        unique_pointer<foo, counting_delete> counted(new foo{1, false});
+    }
+    std::cout << "counting_delete calls: " << counting_delete::calls << std::endl;
+
+    free_list_pool<foo> pool;
+    {
+        auto p1 = pool.make(1, true);
+        auto p2 = pool.make(2, false);
+        std::cout << "pooled: " << p1->a << " " << p2->a
+                  << ", handle size: " << sizeof(p1) << " bytes" << std::endl;
+    }
+    std::cout << "free slots after handles die: " << pool.free_slots() << std::endl;
+    auto p3 = pool.make(3, true); // reuses a recycled slot
+    std::cout << "reused: " << p3->a << std::endl;
+
+    std::cout << "sizeof(unique_pointer<foo>): " << sizeof(unique_pointer<foo>) << std::endl;
+
+    auto pooled = object_pool<foo>::make(4, false);
+    std::cout << "object_pool handle: " << pooled->a << ", size: " << sizeof(pooled) << " bytes" << std::endl;
+}
@@ -0,0 +1,459 @@
+#ifndef UP_H
+#define UP_H
+
+#include<atomic>
+#include<cstddef>
+#include<cstdlib>
+#include<mutex>
+#include<new>
+#include<type_traits>
+#include<utility>
+#include<vector>
+
+template<typename T>
+struct default_delete {
+    void operator() (T* ptr) const noexcept {
+        delete ptr;
+    }
+};
+
+template<typename T>
+struct default_delete<T[]> {
+    void operator() (T* ptr) const noexcept {
+        delete[] ptr;
+    }
+};
+
+// Holds the deleter and the pointer. Empty deleters are a base class so
+// they take no space (empty base optimisation); anything else is a member.
+template<typename D, typename P, bool = std::is_empty_v<D> && !std::is_final_v<D>>
+class compressed_pair : private D {
+public:
+    compressed_pair(D d, P p) : D(std::move(d)), p{p} {}
+
+    D& first() noexcept { return *this; }
+    const D& first() const noexcept { return *this; }
+    P& second() noexcept { return p; }
+    const P& second() const noexcept { return p; }
+
+private:
+    P p;
+};
+
+template<typename D, typename P>
+class compressed_pair<D, P, false> {
+public:
+    compressed_pair(D d, P p) : d{std::move(d)}, p{p} {}
+
+    D& first() noexcept { return d; }
+    const D& first() const noexcept { return d; }
+    P& second() noexcept { return p; }
+    const P& second() const noexcept { return p; }
+
+private:
+    D d;
+    P p;
+};
+
+// Shared by the single-object and array forms
+template<typename T, typename Deleter>
+class unique_pointer_base {
+public:
+    T* get() const noexcept {
+        return storage.second();
+    }
+
+    Deleter& get_deleter() noexcept {
+        return storage.first();
+    }
+
+    const Deleter& get_deleter() const noexcept {
+        return storage.first();
+    }
+
+    explicit operator bool () const noexcept {
+        return get() != nullptr;
+    }
+
+    // give up ownership without deleting
+    T* release() noexcept {
+        T* old = get();
+        storage.second() = nullptr;
+        return old;
+    }
+
+    void reset(T* _ptr = nullptr) noexcept {
+        T* old = get();
+        storage.second() = _ptr;
+        if (old) get_deleter()(old);
+    }
+
+protected:
+    constexpr unique_pointer_base() : storage{Deleter{}, nullptr} {}
+
+    unique_pointer_base(T* _ptr, Deleter deleter) : storage{std::move(deleter), _ptr} {}
+
+    unique_pointer_base(unique_pointer_base&& other) noexcept
+        : storage{std::move(other.get_deleter()), other.release()} {}
+
+    unique_pointer_base& operator= (unique_pointer_base&& other) noexcept {
+        if (this != &other) {
+            reset(other.release());
+            get_deleter() = std::move(other.get_deleter());
+        }
+        return *this;
+    }
+
+    ~unique_pointer_base() {
+        reset();
+    }
+
+private:
+    compressed_pair<Deleter, T*> storage;
+};
+
+template<typename T, typename Deleter = default_delete<T>>
+class unique_pointer : public unique_pointer_base<T, Deleter> {
+    using base = unique_pointer_base<T, Deleter>;
+
+public:
+    constexpr unique_pointer() = default;
+
+    unique_pointer(T* _ptr) : base{_ptr, Deleter{}} {}
+
+    unique_pointer(T* _ptr, Deleter deleter) : base{_ptr, std::move(deleter)} {}
+
+    // copy constructor
+    unique_pointer(const unique_pointer &other) = delete;
+
+    // move constructor
+    unique_pointer(unique_pointer &&other) = default;
+
+    // assignment
+    unique_pointer& operator= (T* other) noexcept {
+        this->reset(other);
+        return *this;
+    }
+
+    // copy assignment
+    void operator= (const unique_pointer &other) = delete;
+
+    // move assignment
+    unique_pointer& operator= (unique_pointer &&other) = default;
+
+    T& operator* () const noexcept {
+        return *this->get();
+    }
+
+    T* operator-> () const noexcept {
+        return this->get();
+    }
+};
+
+// Array form: deletes with delete[] and indexes instead of dereferencing
+template<typename T, typename Deleter>
+class unique_pointer<T[], Deleter> : public unique_pointer_base<T, Deleter> {
+    using base = unique_pointer_base<T, Deleter>;
+
+public:
+    constexpr unique_pointer() = default;
+
+    unique_pointer(T* _ptr) : base{_ptr, Deleter{}} {}
+
+    unique_pointer(T* _ptr, Deleter deleter) : base{_ptr, std::move(deleter)} {}
+
+    unique_pointer(const unique_pointer &other) = delete;
+
+    unique_pointer(unique_pointer &&other) = default;
+
+    unique_pointer& operator= (T* other) noexcept {
+        this->reset(other);
+        return *this;
+    }
+
+    void operator= (const unique_pointer &other) = delete;
+
+    unique_pointer& operator= (unique_pointer &&other) = default;
+
+    T& operator[] (std::size_t index) const noexcept {
+        return this->get()[index];
+    }
+};
+
+template<typename T, typename D, typename U, typename E,
+    typename = std::enable_if_t<std::is_convertible_v<std::remove_extent_t<T>*, std::remove_extent_t<U>*> ||
+                                std::is_convertible_v<std::remove_extent_t<U>*, std::remove_extent_t<T>*> > >
+bool operator== (const unique_pointer<T, D>& first, const unique_pointer<U, E>& second) noexcept {
+    return first.get() == second.get();
+}
+
+// Free list of fixed-size slots. Objects handed out by make() go back onto
+// the list when their unique_pointer dies, instead of being freed.
+// The pool must outlive every handle it has given out.
+template<typename T>
+class free_list_pool {
+    union slot {
+        slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+public:
+    // Stateful deleter: remembers which pool to return the object to
+    struct deleter {
+        free_list_pool* pool = nullptr;
+
+        void operator() (T* ptr) const noexcept {
+            pool->recycle(ptr);
+        }
+    };
+
+    using handle = unique_pointer<T, deleter>;
+
+    free_list_pool() = default;
+    free_list_pool(const free_list_pool&) = delete;
+    free_list_pool& operator= (const free_list_pool&) = delete;
+
+    ~free_list_pool() {
+        while (head) {
+            slot* next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+
+    template<typename... Args>
+    handle make(Args&&... args) {
+        slot* s = head;
+        if (s) {
+            head = s->next;
+            --free_count;
+        } else {
+            s = new slot;
+        }
+        T* obj;
+        try {
+            obj = new (s->storage) T{std::forward<Args>(args)...};
+        } catch (...) {
+            push(s); // T's constructor threw: keep the slot for next time
+            throw;
+        }
+        return handle{obj, deleter{this}};
+    }
+
+    std::size_t free_slots() const noexcept {
+        return free_count;
+    }
+
+private:
+    void recycle(T* ptr) noexcept {
+        ptr->~T();
+        push(reinterpret_cast<slot*>(ptr));
+    }
+
+    void push(slot* s) noexcept {
+        s->next = head;
+        head = s;
+        ++free_count;
+    }
+
+    slot* head = nullptr;
+    std::size_t free_count = 0;
+};
+
+// Per-type object pool for hot-path allocation. Every thread has its own
+// cache of free slots, so allocating and freeing on the same thread touches
+// no atomics. A slot freed on another thread is collected into a batch for
+// its owning cache; a full batch is pushed onto the owner's lock-free
+// remote list with one CAS, and the owner takes the whole list back with a
+// single exchange when its local list runs dry.
+//
+// Caches are never freed while the process runs: when a thread exits its
+// cache is parked for the next new thread, so slots still in flight always
+// have a live owner to return to.
+template<typename T>
+class object_pool {
+    struct cache;
+
+    struct slot {
+        cache* owner;
+        union {
+            slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+    };
+
+    static constexpr std::size_t CHUNK_SLOTS = 64;
+    static constexpr std::size_t BATCH_SIZE = 32;
+
+    struct cache {
+        slot* local_head = nullptr;              // Only touched by the owning thread
+        std::atomic<slot*> remote_head{nullptr}; // Batches returned by other threads
+        std::vector<slot*> chunks;               // For freeing at process exit
+
+        slot* pop() {
+            if (!local_head) {
+                local_head = remote_head.exchange(nullptr, std::memory_order_acquire);
+            }
+            if (!local_head) {
+                grow();
+            }
+            slot* s = local_head;
+            local_head = s->next;
+            return s;
+        }
+
+        void push_local(slot* s) noexcept {
+            s->next = local_head;
+            local_head = s;
+        }
+
+        void grow() {
+            // slot inherits T's alignment, which plain operator new only
+            // honours up to __STDCPP_DEFAULT_NEW_ALIGNMENT__
+            slot* chunk = static_cast<slot*>(::operator new(CHUNK_SLOTS * sizeof(slot), std::align_val_t{alignof(slot)}));
+            try {
+                chunks.push_back(chunk);
+            } catch (...) {
+                ::operator delete(chunk, std::align_val_t{alignof(slot)});
+                throw;
+            }
+            for (std::size_t i = 0; i < CHUNK_SLOTS; ++i) {
+                chunk[i].owner = this;
+                chunk[i].next = i + 1 < CHUNK_SLOTS ? &chunk[i + 1] : nullptr;
+            }
+            local_head = chunk;
+        }
+
+        // Pushes a pre-linked chain of slots in one CAS
+        void push_remote(slot* first, slot* last) {
+            slot* old_head = remote_head.load(std::memory_order_relaxed);
+            do {
+                last->next = old_head;
+            } while (!remote_head.compare_exchange_weak(old_head, first, std::memory_order_release,
+                                                        std::memory_order_relaxed));
+        }
+
+        ~cache() {
+            for (slot* chunk : chunks) {
+                ::operator delete(chunk, std::align_val_t{alignof(slot)});
+            }
+        }
+    };
+
+    // Slots freed by this thread that belong to another thread's cache
+    struct pending_batch {
+        cache* owner = nullptr;
+        slot* first = nullptr;
+        slot* last = nullptr;
+        std::size_t count = 0;
+
+        void add(slot* s) {
+            if (owner != s->owner) {
+                flush();
+                owner = s->owner;
+            }
+            s->next = first;
+            first = s;
+            if (!last) last = s;
+            if (++count == BATCH_SIZE) flush();
+        }
+
+        void flush() {
+            if (first) owner->push_remote(first, last);
+            first = last = nullptr;
+            count = 0;
+        }
+    };
+
+    struct registry {
+        std::mutex mutex;
+        std::vector<cache*> all;
+        std::vector<cache*> parked;
+
+        cache* acquire() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!parked.empty()) {
+                cache* c = parked.back();
+                parked.pop_back();
+                return c;
+            }
+            all.push_back(new cache);
+            return all.back();
+        }
+
+        void park(cache* c) {
+            std::lock_guard<std::mutex> lock(mutex);
+            parked.push_back(c);
+        }
+
+        ~registry() {
+            for (cache* c : all) delete c;
+        }
+    };
+
+    static registry& get_registry() {
+        static registry r;
+        return r;
+    }
+
+    struct thread_state {
+        cache* own;
+        pending_batch pending;
+
+        thread_state() : own{get_registry().acquire()} {}
+
+        ~thread_state() {
+            pending.flush();
+            get_registry().park(own);
+        }
+    };
+
+    static thread_state& state() {
+        thread_local thread_state ts;
+        return ts;
+    }
+
+    static slot* slot_of(T* ptr) {
+        return reinterpret_cast<slot*>(reinterpret_cast<char*>(ptr) - offsetof(slot, storage));
+    }
+
+public:
+    // Stateless, so handles stay one pointer wide
+    struct deleter {
+        void operator() (T* ptr) const noexcept {
+            recycle(ptr);
+        }
+    };
+
+    using handle = unique_pointer<T, deleter>;
+
+    template<typename... Args>
+    static handle make(Args&&... args) {
+        cache* own = state().own;
+        slot* s = own->pop();
+        try {
+            return handle{new (s->storage) T{std::forward<Args>(args)...}};
+        } catch (...) {
+            own->push_local(s); // T's constructor threw: the slot was never handed out
+            throw;
+        }
+    }
+
+    static void recycle(T* ptr) noexcept {
+        ptr->~T();
+        slot* s = slot_of(ptr);
+        thread_state& ts = state();
+        if (s->owner == ts.own) {
+            ts.own->push_local(s);
+        } else {
+            ts.pending.add(s);
+        }
+    }
+
+    // Hand any partially filled batch back to its owner now
+    static void flush() {
+        state().pending.flush();
+    }
+};
+
+#endif
@@ -1,125 +1,6 @@
 #include <iostream>
 #include <stdexcept>
-
-template <typename T>
-class Vector {
-private:
-    T* data;       // Pointer to dynamically allocated array
-    std::size_t sz; // Number of elements in the vector
-    std::size_t cap; // Allocated capacity
-
-    void resize_capacity(std::size_t new_capacity) {
-        T* new_data = new T[new_capacity];
-        for (std::size_t i = 0; i < sz; ++i) {
-            new_data[i] = std::move(data[i]);
-        }
-        delete[] data;
-        data = new_data;
-        cap = new_capacity;
-    }
-
-public:
-    // Constructor
-    Vector() : data(nullptr), sz(0), cap(0) {}
-
-    // Destructor
-    ~Vector() {
-        delete[] data;
-    }
-
-    // Copy constructor
-    Vector(const Vector& other) : sz(other.sz), cap(other.cap) {
-        data = new T[cap];
-        for (std::size_t i = 0; i < sz; ++i) {
-            data[i] = other.data[i];
-        }
-    }
-
-    // Move constructor
-    Vector(Vector&& other) noexcept : data(other.data), sz(other.sz), cap(other.cap) {
-        other.data = nullptr;
-        other.sz = 0;
-        other.cap = 0;
-    }
-
-    // Copy assignment
-    Vector& operator=(const Vector& other) {
-        if (this != &other) {
-            delete[] data;
-            sz = other.sz;
-            cap = other.cap;
-            data = new T[cap];
-            for (std::size_t i = 0; i < sz; ++i) {
-                data[i] = other.data[i];
-            }
-        }
-        return *this;
-    }
-
-    // Move assignment
-    Vector& operator=(Vector&& other) noexcept {
-        if (this != &other) {
-            delete[] data;
-            data = other.data;
-            sz = other.sz;
-            cap = other.cap;
-            other.data = nullptr;
-            other.sz = 0;
-            other.cap = 0;
-        }
-        return *this;
-    }
-
-    // Return size of the vector
-    std::size_t size() const {
-        return sz;
-    }
-
-    // Return capacity of the vector
-    std::size_t capacity() const {
-        return cap;
-    }
-
-    // Check if vector is empty
-    bool empty() const {
-        return sz == 0;
-    }
-
-    // Access element at index (with bounds checking)
-    T& operator[](std::size_t index) {
-        if (index >= sz) {
-            throw std::out_of_range("Index out of range");
-        }
-        return data[index];
-    }
-
-    const T& operator[](std::size_t index) const {
-        if (index >= sz) {
-            throw std::out_of_range("Index out of range");
-        }
-        return data[index];
-    }
-
-    // Add element to the end
-    void push_back(const T& value) {
-        if (sz == cap) {
-            resize_capacity(cap == 0 ? 1 : cap * 2);
-        }
-        data[sz++] = value;
-    }
-
-    // Remove last element
-    void pop_back() {
-        if (sz > 0) {
-            --sz;
-        }
-    }
-
-    // Clear the vector
-    void clear() {
-        sz = 0;
-    }
-};
+#include "vector.hpp"
 
 int main() {
     Vector<int> vec;
@@ -137,5 +18,22 @@ int main() {
     vec.pop_back();
     std::cout << "After pop_back, size: " << vec.size() << "\n";
 
+    SmallVector<int, 4> small;
+    for (int i = 1; i <= 4; ++i) {
+        small.push_back(i * 10);
+    }
+    std::cout << "SmallVector size: " << small.size() << ", inline: " << std::boolalpha << small.is_inline() << "\n";
+    small.push_back(50);
+    std::cout << "After 5th push_back, inline: " << small.is_inline() << ", capacity: " << small.capacity() << "\n";
+
+    SmallVector<int, 4> moved = std::move(small); // Heap buffer is stolen, no copy
+    std::cout << "Moved size: " << moved.size() << ", source inline again: " << small.is_inline() << "\n";
+
+    try {
+        moved.at(10);
+    } catch (const std::out_of_range&) {
+        std::cout << "at(10) threw out_of_range\n";
+    }
+
     return 0;
 }
@@ -0,0 +1,479 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>   // For std::uninitialized_copy, std::uninitialized_move
+#include <new>      // For placement new, operator new
+#include <stdexcept>
+#include <type_traits>
+#include <utility>  // For std::move
+#include "instrumentation.hpp"
+
+// Bounds checking policies for operator[]; at() always checks and throws.
+// unchecked_bounds keeps the indexing loop branch-free so it can vectorise.
+struct unchecked_bounds {
+    static void check(std::size_t, std::size_t) {}
+};
+
+// Asserts in debug builds, compiles to nothing under NDEBUG
+struct assert_bounds {
+    static void check(std::size_t index, std::size_t sz) {
+        assert(index < sz && "Index out of range");
+        (void)index;
+        (void)sz;
+    }
+};
+
+// Traps instead of throwing, so no exception path is emitted
+struct hardened_bounds {
+    static void check(std::size_t index, std::size_t sz) {
+        if (__builtin_expect(index >= sz, 0)) {
+            __builtin_trap();
+        }
+    }
+};
+
+template <typename T, typename Bounds = unchecked_bounds>
+class Vector {
+private:
+    T* elems;      // Pointer to dynamically allocated array
+    std::size_t sz; // Number of elements in the vector
+    std::size_t cap; // Allocated capacity
+
+    static constexpr instrumentation::component tag = instrumentation::component::vector;
+
+    static T* allocate(std::size_t count) {
+        instrumentation::on_alloc(tag, count * sizeof(T));
+        return new T[count];
+    }
+
+    static void deallocate(T* ptr, std::size_t count) {
+        if (ptr) {
+            instrumentation::on_free(tag, count * sizeof(T));
+        }
+        delete[] ptr;
+    }
+
+    void resize_capacity(std::size_t new_capacity) {
+        T* new_data = allocate(new_capacity);
+        for (std::size_t i = 0; i < sz; ++i) {
+            new_data[i] = std::move(elems[i]);
+        }
+        instrumentation::on_growth(tag);
+        instrumentation::on_move(tag, sz * sizeof(T));
+        deallocate(elems, cap);
+        elems = new_data;
+        cap = new_capacity;
+    }
+
+public:
+    // Constructor
+    Vector() : elems(nullptr), sz(0), cap(0) {}
+
+    // Destructor
+    ~Vector() {
+        deallocate(elems, cap);
+    }
+
+    // Copy constructor
+    Vector(const Vector& other) : sz(other.sz), cap(other.cap) {
+        elems = allocate(cap);
+        for (std::size_t i = 0; i < sz; ++i) {
+            elems[i] = other.elems[i];
+        }
+        instrumentation::on_copy(tag, sz * sizeof(T));
+    }
+
+    // Move constructor
+    Vector(Vector&& other) noexcept : elems(other.elems), sz(other.sz), cap(other.cap) {
+        other.elems = nullptr;
+        other.sz = 0;
+        other.cap = 0;
+    }
+
+    // Copy assignment
+    Vector& operator=(const Vector& other) {
+        if (this != &other) {
+            deallocate(elems, cap);
+            sz = other.sz;
+            cap = other.cap;
+            elems = allocate(cap);
+            for (std::size_t i = 0; i < sz; ++i) {
+                elems[i] = other.elems[i];
+            }
+            instrumentation::on_copy(tag, sz * sizeof(T));
+        }
+        return *this;
+    }
+
+    // Move assignment
+    Vector& operator=(Vector&& other) noexcept {
+        if (this != &other) {
+            deallocate(elems, cap);
+            elems = other.elems;
+            sz = other.sz;
+            cap = other.cap;
+            other.elems = nullptr;
+            other.sz = 0;
+            other.cap = 0;
+        }
+        return *this;
+    }
+
+    // Return size of the vector
+    std::size_t size() const {
+        return sz;
+    }
+
+    // Return capacity of the vector
+    std::size_t capacity() const {
+        return cap;
+    }
+
+    // Check if vector is empty
+    bool empty() const {
+        return sz == 0;
+    }
+
+    // Access element at index (checked according to Bounds)
+    T& operator[](std::size_t index) {
+        Bounds::check(index, sz);
+        return elems[index];
+    }
+
+    const T& operator[](std::size_t index) const {
+        Bounds::check(index, sz);
+        return elems[index];
+    }
+
+    // Access element at index (with bounds checking)
+    T& at(std::size_t index) {
+        if (index >= sz) {
+            throw std::out_of_range("Index out of range");
+        }
+        return elems[index];
+    }
+
+    const T& at(std::size_t index) const {
+        if (index >= sz) {
+            throw std::out_of_range("Index out of range");
+        }
+        return elems[index];
+    }
+
+
+    // Contiguous access for tight loops
+    T* data() {
+        return elems;
+    }
+
+    const T* data() const {
+        return elems;
+    }
+
+    T* begin() {
+        return elems;
+    }
+
+    T* end() {
+        return elems + sz;
+    }
+
+    const T* begin() const {
+        return elems;
+    }
+
+    const T* end() const {
+        return elems + sz;
+    }
+
+    // Add element to the end
+    void push_back(const T& value) {
+        if (sz == cap) {
+            resize_capacity(cap == 0 ? 1 : cap * 2);
+        }
+        elems[sz++] = value;
+    }
+
+    // Remove last element
+    void pop_back() {
+        if (sz > 0) {
+            --sz;
+        }
+    }
+
+    // Clear the vector
+    void clear() {
+        sz = 0;
+    }
+};
+
+
+// Vector with inline storage for the first N elements.
+// Only spills to the heap once more than N elements are pushed.
+template <typename T, std::size_t N, typename Bounds = unchecked_bounds>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline slot");
+
+private:
+    alignas(T) unsigned char inline_buffer[N * sizeof(T)]; // Raw storage for N elements
+    T* elems;       // Points at inline_buffer or at a heap array
+    std::size_t sz; // Number of elements in the vector
+    std::size_t cap; // N while inline, heap capacity otherwise
+
+    T* inline_data() {
+        return reinterpret_cast<T*>(inline_buffer);
+    }
+
+    const T* inline_data() const {
+        return reinterpret_cast<const T*>(inline_buffer);
+    }
+
+    static constexpr instrumentation::component tag = instrumentation::component::small_vector;
+
+    static T* allocate(std::size_t count) {
+        instrumentation::on_alloc(tag, count * sizeof(T));
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate_heap() {
+        instrumentation::on_free(tag, cap * sizeof(T));
+        ::operator delete(elems);
+    }
+
+    static constexpr bool nothrow_move = std::is_nothrow_move_constructible_v<T>;
+
+    // Elements are constructed in place, so unused slots hold no objects.
+    // Like std::vector, the old elements are only destroyed once all of them
+    // made it into the new buffer, and they are copied rather than moved if a
+    // move could throw: a throwing element leaves the vector untouched.
+    void resize_capacity(std::size_t new_capacity) {
+        T* new_data = allocate(new_capacity);
+        try {
+            if constexpr (nothrow_move || !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(elems, elems + sz, new_data);
+            } else {
+                std::uninitialized_copy(elems, elems + sz, new_data);
+            }
+        } catch (...) {
+            instrumentation::on_free(tag, new_capacity * sizeof(T));
+            ::operator delete(new_data);
+            throw;
+        }
+        for (std::size_t i = 0; i < sz; ++i) {
+            elems[i].~T();
+        }
+        instrumentation::on_growth(tag);
+        instrumentation::on_move(tag, sz * sizeof(T));
+        if (!is_inline()) {
+            deallocate_heap();
+        }
+        elems = new_data;
+        cap = new_capacity;
+    }
+
+    void destroy_elements() {
+        for (std::size_t i = 0; i < sz; ++i) {
+            elems[i].~T();
+        }
+        sz = 0;
+    }
+
+    void release_heap() {
+        if (!is_inline()) {
+            deallocate_heap();
+            elems = inline_data();
+            cap = N;
+        }
+    }
+
+    // Expects an empty, inline vector. If a copy throws, the copies made so
+    // far are destroyed and the vector is left empty and inline again.
+    void copy_from(const SmallVector& other) {
+        if (other.sz > N) {
+            elems = allocate(other.sz);
+            cap = other.sz;
+        }
+        try {
+            std::uninitialized_copy(other.elems, other.elems + other.sz, elems);
+        } catch (...) {
+            release_heap();
+            throw;
+        }
+        instrumentation::on_copy(tag, other.sz * sizeof(T));
+        sz = other.sz;
+    }
+
+    // Heap buffers are stolen; inline elements have to be moved one by one,
+    // which can throw unless T's move constructor is noexcept. This vector is
+    // then left empty and other keeps its elements (some possibly moved-from).
+    void move_from(SmallVector&& other) noexcept(nothrow_move) {
+        if (other.is_inline()) {
+            std::uninitialized_move(other.elems, other.elems + other.sz, elems);
+            instrumentation::on_move(tag, other.sz * sizeof(T));
+            sz = other.sz;
+            other.destroy_elements();
+        } else {
+            elems = other.elems;
+            sz = other.sz;
+            cap = other.cap;
+            other.elems = other.inline_data();
+            other.sz = 0;
+            other.cap = N;
+        }
+    }
+
+public:
+    // Constructor
+    SmallVector() : elems(inline_data()), sz(0), cap(N) {}
+
+    // Destructor
+    ~SmallVector() {
+        // Each vector counts once, by where its elements ended up
+        if (sz > 0 || !is_inline()) {
+            instrumentation::on_placement(tag, is_inline());
+        }
+        destroy_elements();
+        release_heap();
+    }
+
+    // Copy constructor
+    SmallVector(const SmallVector& other) : elems(inline_data()), sz(0), cap(N) {
+        copy_from(other);
+    }
+
+    // Move constructor
+    SmallVector(SmallVector&& other) noexcept(nothrow_move) : elems(inline_data()), sz(0), cap(N) {
+        move_from(std::move(other));
+    }
+
+    // Copy assignment
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            destroy_elements();
+            release_heap();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    // Move assignment
+    SmallVector& operator=(SmallVector&& other) noexcept(nothrow_move) {
+        if (this != &other) {
+            destroy_elements();
+            release_heap();
+            move_from(std::move(other));
+        }
+        return *this;
+    }
+
+    // Return size of the vector
+    std::size_t size() const {
+        return sz;
+    }
+
+    // Return capacity of the vector
+    std::size_t capacity() const {
+        return cap;
+    }
+
+    // Check if vector is empty
+    bool empty() const {
+        return sz == 0;
+    }
+
+    // Check if elements still live in the inline buffer
+    bool is_inline() const {
+        return elems == inline_data();
+    }
+
+    // Access element at index (checked according to Bounds)
+    T& operator[](std::size_t index) {
+        Bounds::check(index, sz);
+        return elems[index];
+    }
+
+    const T& operator[](std::size_t index) const {
+        Bounds::check(index, sz);
+        return elems[index];
+    }
+
+    // Access element at index (with bounds checking)
+    T& at(std::size_t index) {
+        if (index >= sz) {
+            throw std::out_of_range("Index out of range");
+        }
+        return elems[index];
+    }
+
+    const T& at(std::size_t index) const {
+        if (index >= sz) {
+            throw std::out_of_range("Index out of range");
+        }
+        return elems[index];
+    }
+
+
+    // Contiguous access for tight loops
+    T* data() {
+        return elems;
+    }
+
+    const T* data() const {
+        return elems;
+    }
+
+    T* begin() {
+        return elems;
+    }
+
+    T* end() {
+        return elems + sz;
+    }
+
+    const T* begin() const {
+        return elems;
+    }
+
+    const T* end() const {
+        return elems + sz;
+    }
+
+    // Add element to the end
+    void push_back(const T& value) {
+        if (sz == cap) {
+            T copy(value); // value may live inside the buffer being reallocated
+            resize_capacity(cap * 2);
+            new (elems + sz) T(std::move(copy));
+        } else {
+            new (elems + sz) T(value);
+        }
+        ++sz;
+    }
+
+    void push_back(T&& value) {
+        if (sz == cap) {
+            T moved(std::move(value));
+            resize_capacity(cap * 2);
+            new (elems + sz) T(std::move(moved));
+        } else {
+            new (elems + sz) T(std::move(value));
+        }
+        ++sz;
+    }
+
+    // Remove last element
+    void pop_back() {
+        if (sz > 0) {
+            elems[--sz].~T();
+        }
+    }
+
+    // Clear the vector (keeps any heap buffer for reuse)
+    void clear() {
+        destroy_elements();
+    }
+};
+
+#endif
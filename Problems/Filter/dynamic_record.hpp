@@ -0,0 +1,245 @@
+#ifndef DYNAMIC_RECORD_H
+#define DYNAMIC_RECORD_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// Records whose fields are only known at runtime, stored column by column.
+// Each column keeps its values contiguously as their real type (no per-cell
+// boxing), and is type-erased the same way Any is: a static table of
+// function pointers per stored type, whose address also identifies the type.
+// record_table hands out lightweight dynamic_record handles (table + row),
+// so record_processor can filter and sort them like any other record.
+
+struct column_ops {
+    size_t size;
+    size_t align;
+    void (*destroy)(void* values, size_t count);
+    void (*relocate)(void* from, void* to, size_t count); // Move-construct into `to`, destroy `from`
+
+    template <typename T>
+    static const column_ops* of() {
+        static const column_ops ops {
+            sizeof(T),
+            alignof(T),
+            [](void* values, size_t count) {
+                T* typed = static_cast<T*>(values);
+                for (size_t i = 0; i < count; i++) typed[i].~T();
+            },
+            [](void* from, void* to, size_t count) {
+                T* src = static_cast<T*>(from);
+                T* dst = static_cast<T*>(to);
+                for (size_t i = 0; i < count; i++) {
+                    new (dst + i) T(std::move(src[i]));
+                    src[i].~T();
+                }
+            }
+        };
+        return &ops;
+    }
+};
+
+class column {
+public:
+    column(string _name, const column_ops* _ops): name {std::move(_name)}, ops {_ops} { }
+
+    column(const column&) = delete;
+    column& operator= (const column&) = delete;
+
+    column(column&& other) noexcept:
+        name {std::move(other.name)}, ops {other.ops}, values {other.values}, count {other.count}, cap {other.cap} {
+        other.values = nullptr;
+        other.count = other.cap = 0;
+    }
+
+    ~column() {
+        if (values) {
+            ops->destroy(values, count);
+            ::operator delete(values, align_val_t {ops->align});
+        }
+    }
+
+    const string& get_name() const { return name; }
+
+    template <typename T>
+    bool holds() const { return ops == column_ops::of<T>(); }
+
+    // One type check per call; the returned pointer is the contiguous column
+    template <typename T>
+    T* data() {
+        if (!holds<T>()) throw bad_cast();
+        return static_cast<T*>(values);
+    }
+
+    template <typename T>
+    const T* data() const {
+        if (!holds<T>()) throw bad_cast();
+        return static_cast<const T*>(values);
+    }
+
+    // For callers that already checked holds<T>(), e.g. field<T>
+    template <typename T>
+    const T* unchecked_data() const {
+        return static_cast<const T*>(values);
+    }
+
+    template <typename T>
+    void push_back(T value) {
+        T* typed = data<T>();
+        if (count == cap) {
+            grow();
+            typed = static_cast<T*>(values);
+        }
+        new (typed + count) T(std::move(value));
+        count++;
+    }
+
+    void pop_back() {
+        count--;
+        ops->destroy(static_cast<char*>(values) + count * ops->size, 1);
+    }
+
+private:
+    void grow() {
+        size_t new_cap = cap == 0 ? 16 : cap * 2;
+        void* new_values = ::operator new(new_cap * ops->size, align_val_t {ops->align});
+        if (values) {
+            ops->relocate(values, new_values, count);
+            ::operator delete(values, align_val_t {ops->align});
+        }
+        values = new_values;
+        cap = new_cap;
+    }
+
+    string name;
+    const column_ops* ops;
+    void* values = nullptr;
+    size_t count = 0;
+    size_t cap = 0;
+};
+
+class record_table;
+
+// Handle to one row; cheap to copy, filter and sort
+class dynamic_record {
+public:
+    dynamic_record(const record_table* _table, size_t _row): table {_table}, row {_row} { }
+
+    size_t get_row() const { return row; }
+
+    template <typename T>
+    const T& get(size_t column_index) const;
+
+    template <typename T>
+    const T& get(const string& column_name) const;
+
+    void log() const;
+
+private:
+    const record_table* table;
+    size_t row;
+};
+
+// Typed accessor for one column, resolved once up front. Calling it on a
+// record is a plain array index, with no name lookup or type check per cell.
+template <typename T>
+class field {
+public:
+    field(const column& _col): col {&_col} {
+        if (!col->holds<T>()) throw bad_cast();
+    }
+
+    const T& operator() (const dynamic_record& record) const {
+        return col->unchecked_data<T>()[record.get_row()];
+    }
+
+private:
+    const column* col;
+};
+
+class record_table {
+    template <typename T>
+    using stored_type = conditional_t<is_convertible_v<decay_t<T>, const char*>, string, decay_t<T>>;
+
+public:
+    template <typename T>
+    record_table& add_column(const string& name) {
+        if (rows > 0) throw logic_error("columns must be added before rows");
+        columns.emplace_back(name, column_ops::of<T>());
+        return *this;
+    }
+
+    size_t size() const { return rows; }
+
+    size_t column_count() const { return columns.size(); }
+
+    size_t column_index(const string& name) const {
+        for (size_t i = 0; i < columns.size(); i++) {
+            if (columns[i].get_name() == name) return i;
+        }
+        throw out_of_range("no column named " + name);
+    }
+
+    const column& get_column(size_t index) const { return columns[index]; }
+
+    const column& get_column(const string& name) const { return columns[column_index(name)]; }
+
+    template <typename T>
+    field<T> get_field(const string& name) const { return field<T> {get_column(name)}; }
+
+    // Values must match the schema's column order and types
+    // (string literals are stored as string). Every column is checked
+    // before any is written, so a bad row leaves the table unchanged.
+    template <typename... Ts>
+    void add_row(Ts&&... values) {
+        if (sizeof...(Ts) != columns.size()) throw invalid_argument("row does not match schema");
+        size_t index = 0;
+        bool types_match = (columns[index++].holds<stored_type<Ts>>() && ...);
+        if (!types_match) throw bad_cast();
+        // A throwing copy or allocation can still stop part way: undo those cells
+        size_t pushed = 0;
+        try {
+            ((columns[pushed].push_back<stored_type<Ts>>(std::forward<Ts>(values)), pushed++), ...);
+        } catch (...) {
+            while (pushed > 0) columns[--pushed].pop_back();
+            throw;
+        }
+        rows++;
+    }
+
+    vector<dynamic_record> records() const {
+        vector<dynamic_record> handles;
+        handles.reserve(rows);
+        for (size_t i = 0; i < rows; i++) handles.emplace_back(this, i);
+        return handles;
+    }
+
+private:
+    vector<column> columns;
+    size_t rows = 0;
+};
+
+template <typename T>
+const T& dynamic_record::get(size_t column_index) const {
+    return table->get_column(column_index).data<T>()[row];
+}
+
+template <typename T>
+const T& dynamic_record::get(const string& column_name) const {
+    return table->get_column(column_name).data<T>()[row];
+}
+
+inline void dynamic_record::log() const {
+    std::cout << '(';
+    for (size_t i = 0; i < table->column_count(); i++) {
+        const column& col = table->get_column(i);
+        if (i > 0) std::cout << ", ";
+        if (col.holds<int>()) std::cout << col.data<int>()[row];
+        else if (col.holds<string>()) std::cout << col.data<string>()[row];
+        else if (col.holds<double>()) std::cout << col.data<double>()[row];
+        else std::cout << '?';
+    }
+    std::cout << ')' << std::endl;
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "and_condition.hpp"
 #include "record_processor.hpp"
 #include "transaction.hpp"
+#include "dynamic_record.hpp"
 #include <bits/stdc++.h>
 
 int main() {
@@ -34,4 +35,23 @@ int main() {
         txn.log();
     }
 
-}
\ No newline at end of file
+    // Same data with a schema only known at runtime
+    record_table table;
+    table.add_column<int>("id").add_column<string>("from_id").add_column<string>("to_id")
+         .add_column<int>("amount").add_column<int>("timestamp");
+    for (transaction txn: transactions) {
+        table.add_row(txn.get_id(), txn.get_from_id(), txn.get_to_id(), txn.get_amount(), txn.get_timestamp());
+    }
+
+    vector<dynamic_record> rows = table.records();
+    record_processor<dynamic_record> rpd {rows};
+    field<string> to_id = table.get_field<string>("to_id");
+    field<int> amount = table.get_field<int>("amount");
+    condition<dynamic_record> rows_to_u3 { [&to_id](dynamic_record &r) { return to_id(r) == "u3"; } };
+    rpd.filter_records(rows_to_u3).sort([&amount](dynamic_record &r1, dynamic_record &r2) { return amount(r1) < amount(r2); });
+    cout << "Dynamic records to u3:\n";
+    for (dynamic_record row: rpd.get_page(10)) {
+        row.log();
+    }
+
+}
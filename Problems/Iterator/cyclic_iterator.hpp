@@ -0,0 +1,26 @@
+#ifndef CYCLIC_ITERATOR_H
+#define CYCLIC_ITERATOR_H
+
+#include "resettable_iterator.hpp"
+
+template <typename T>
+class cyclic_iterator : public custom_iterator<T> {
+public:
+    explicit cyclic_iterator(resettable_iterator<T> &_r_it): r_it {_r_it} { 
+        // assert r_it.has_next() == true;
+    }
+
+    bool has_next() override {
+        return true;
+    }
+
+    T next() override {
+        if (!r_it.has_next()) r_it.reset();
+        return r_it.next();
+    }
+
+private:
+    resettable_iterator<T> &r_it;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <any>
+#include <string>
+#include "any.hpp"
+
+// The same construction/copy/cast workload through Any and std::any.
+// Cast picks the matching pointer-form any_cast for each side.
+struct any_cast_ops {
+    template <typename T>
+    static const T* get(const Any& a) { return any_cast<T>(&a); }
+};
+
+struct std_any_cast_ops {
+    template <typename T>
+    static const T* get(const std::any& a) { return std::any_cast<T>(&a); }
+};
+
+template <typename AnyType, typename Cast>
+static void BM_construct_int(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        AnyType a = i++;
+        benchmark::DoNotOptimize(*Cast::template get<int>(a));
+    }
+}
+BENCHMARK_TEMPLATE(BM_construct_int, std::any, std_any_cast_ops);
+BENCHMARK_TEMPLATE(BM_construct_int, Any, any_cast_ops);
+
+template <typename AnyType, typename Cast>
+static void BM_copy_int(benchmark::State& state) {
+    const AnyType source = 7;
+    for (auto _ : state) {
+        AnyType a = source;
+        benchmark::DoNotOptimize(*Cast::template get<int>(a));
+    }
+}
+BENCHMARK_TEMPLATE(BM_copy_int, std::any, std_any_cast_ops);
+BENCHMARK_TEMPLATE(BM_copy_int, Any, any_cast_ops);
+
+template <typename AnyType, typename Cast>
+static void BM_cast_int(benchmark::State& state) {
+    const AnyType source = 7;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(source);
+        benchmark::DoNotOptimize(Cast::template get<int>(source));
+    }
+}
+BENCHMARK_TEMPLATE(BM_cast_int, std::any, std_any_cast_ops);
+BENCHMARK_TEMPLATE(BM_cast_int, Any, any_cast_ops);
+
+template <typename AnyType, typename Cast>
+static void BM_copy_string(benchmark::State& state) {
+    const AnyType source = std::string("transaction-u1-u2");
+    for (auto _ : state) {
+        AnyType a = source;
+        benchmark::DoNotOptimize(Cast::template get<std::string>(a));
+    }
+}
+BENCHMARK_TEMPLATE(BM_copy_string, std::any, std_any_cast_ops);
+BENCHMARK_TEMPLATE(BM_copy_string, Any, any_cast_ops);
+
+// Too big for either inline buffer, so both sides allocate
+struct large_value {
+    long long fields[8];
+};
+
+template <typename AnyType, typename Cast>
+static void BM_copy_large(benchmark::State& state) {
+    const AnyType source = large_value{};
+    for (auto _ : state) {
+        AnyType a = source;
+        benchmark::DoNotOptimize(Cast::template get<large_value>(a));
+    }
+}
+BENCHMARK_TEMPLATE(BM_copy_large, std::any, std_any_cast_ops);
+BENCHMARK_TEMPLATE(BM_copy_large, Any, any_cast_ops);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include "condition.hpp"
+#include "record_processor.hpp"
+#include "transaction.hpp"
+#include "dynamic_record.hpp"
+
+// Filters transactions with amount >= 50 and sorts them by amount,
+// through record_processor and directly with std::copy_if + std::sort
+
+static const int records = 100000;
+
+static vector<transaction> make_transactions() {
+    vector<transaction> out;
+    out.reserve(records);
+    for (int i = 0; i < records; i++) {
+        out.emplace_back(i, "u" + to_string(i % 100), "u" + to_string((i * 7) % 100), (i * 37) % 100, 100 + i);
+    }
+    return out;
+}
+
+static void BM_filter_sort_transaction(benchmark::State& state) {
+    vector<transaction> transactions = make_transactions();
+    condition<transaction> large { [](transaction& t) { return t.get_amount() >= 50; } };
+    for (auto _ : state) {
+        record_processor<transaction> rp {transactions};
+        rp.filter_records(large).sort([](transaction& a, transaction& b) { return a.get_amount() < b.get_amount(); });
+        benchmark::DoNotOptimize(rp.get_page(1));
+    }
+    state.SetItemsProcessed(state.iterations() * records);
+}
+BENCHMARK(BM_filter_sort_transaction)->Unit(benchmark::kMillisecond);
+
+static void BM_filter_sort_dynamic_record(benchmark::State& state) {
+    vector<transaction> transactions = make_transactions();
+    record_table table;
+    table.add_column<int>("id").add_column<string>("from_id").add_column<string>("to_id")
+         .add_column<int>("amount").add_column<int>("timestamp");
+    for (transaction& t : transactions) {
+        table.add_row(t.get_id(), t.get_from_id(), t.get_to_id(), t.get_amount(), t.get_timestamp());
+    }
+    vector<dynamic_record> rows = table.records();
+    field<int> amount = table.get_field<int>("amount");
+    condition<dynamic_record> large { [&amount](dynamic_record& r) { return amount(r) >= 50; } };
+    for (auto _ : state) {
+        record_processor<dynamic_record> rp {rows};
+        rp.filter_records(large).sort([&amount](dynamic_record& a, dynamic_record& b) { return amount(a) < amount(b); });
+        benchmark::DoNotOptimize(rp.get_page(1));
+    }
+    state.SetItemsProcessed(state.iterations() * records);
+}
+BENCHMARK(BM_filter_sort_dynamic_record)->Unit(benchmark::kMillisecond);
+
+static void BM_filter_sort_std(benchmark::State& state) {
+    vector<transaction> transactions = make_transactions();
+    for (auto _ : state) {
+        vector<transaction> matched;
+        copy_if(transactions.begin(), transactions.end(), back_inserter(matched),
+                [](transaction& t) { return t.get_amount() >= 50; });
+        std::sort(matched.begin(), matched.end(), [](transaction& a, transaction& b) { return a.get_amount() < b.get_amount(); });
+        benchmark::DoNotOptimize(matched.data());
+    }
+    state.SetItemsProcessed(state.iterations() * records);
+}
+BENCHMARK(BM_filter_sort_std)->Unit(benchmark::kMillisecond);
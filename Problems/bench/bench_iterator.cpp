@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "range_iterator.hpp"
+#include "cyclic_iterator.hpp"
+#include "zigzag_iterator.hpp"
+
+// range_iterator goes through a virtual call per element; compare with the loop it replaces
+static void BM_range_loop(benchmark::State& state) {
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int i = 0; i < state.range(0); i += 2) sum += i;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK(BM_range_loop)->Arg(1 << 16);
+
+static void BM_range_iterator(benchmark::State& state) {
+    for (auto _ : state) {
+        range_iterator r(0, static_cast<int>(state.range(0)), 2);
+        long long sum = 0;
+        while (r.has_next()) sum += r.next();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK(BM_range_iterator)->Arg(1 << 16);
+
+static void BM_cyclic_iterator(benchmark::State& state) {
+    range_iterator r(1, 8, 2);
+    cyclic_iterator<int> c(r);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int i = 0; i < state.range(0); i++) sum += c.next();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_cyclic_iterator)->Arg(1 << 16);
+
+static vector<vector<int>> make_ragged(int lists) {
+    vector<vector<int>> v(lists);
+    for (int i = 0; i < lists; i++) v[i].assign(i % 7 * 64, i);
+    return v;
+}
+
+// Round-robin over the lists by index, without the iterator's queue
+static void BM_zigzag_loop(benchmark::State& state) {
+    vector<vector<int>> v = make_ragged(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        long long sum = 0;
+        bool any = true;
+        for (size_t pos = 0; any; pos++) {
+            any = false;
+            for (const vector<int>& list : v) {
+                if (pos < list.size()) {
+                    sum += list[pos];
+                    any = true;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_zigzag_loop)->Arg(64);
+
+static void BM_zigzag_iterator(benchmark::State& state) {
+    vector<vector<int>> v = make_ragged(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        zigzag_iterator<int> z(v); // Copies the lists, like the demo does
+        long long sum = 0;
+        while (z.has_next()) sum += z.next();
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_zigzag_iterator)->Arg(64);
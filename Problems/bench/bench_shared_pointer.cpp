@@ -0,0 +1,178 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "shared_pointer.hpp"
+
+template <typename Ptr, typename Make>
+static void run_creation(benchmark::State& state, Make make) {
+    int i = 0;
+    for (auto _ : state) {
+        Ptr p = make(i++);
+        benchmark::DoNotOptimize(p.get());
+    }
+}
+
+static void BM_create_std_make_shared(benchmark::State& state) {
+    run_creation<std::shared_ptr<int>>(state, [](int i) { return std::make_shared<int>(i); });
+}
+BENCHMARK(BM_create_std_make_shared);
+
+static void BM_create_shared_ptr_new(benchmark::State& state) {
+    run_creation<SharedPtr<int>>(state, [](int i) { return SharedPtr<int>(new int(i)); });
+}
+BENCHMARK(BM_create_shared_ptr_new);
+
+static void BM_create_make_shared(benchmark::State& state) {
+    run_creation<SharedPtr<int>>(state, [](int i) { return make_shared<int>(i); });
+}
+BENCHMARK(BM_create_make_shared);
+
+// Threads copy and destroy pointers to one shared object, hammering its count
+template <typename Ptr>
+static void BM_copy_contended(benchmark::State& state) {
+    static Ptr shared;
+    if (state.thread_index() == 0) shared = Ptr(new int(1));
+    for (auto _ : state) {
+        Ptr copy = shared;
+        benchmark::DoNotOptimize(copy.get());
+    }
+    if (state.thread_index() == 0) shared = Ptr();
+}
+BENCHMARK_TEMPLATE(BM_copy_contended, std::shared_ptr<int>)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_copy_contended, SharedPtr<int>)->ThreadRange(1, 4)->UseRealTime();
+
+struct CachedRecord : RefCounted<CachedRecord> {
+    int key;
+    char payload[48];
+
+    explicit CachedRecord(int k) : key(k), payload{} {}
+};
+
+// Lookups over a key space larger than the cache. Callers keep the last few
+// results alive; `evict` runs whenever the cache grows past its capacity.
+template <typename Handle, typename Entry, typename Load, typename Make, typename Evict>
+static void run_cache(benchmark::State& state, Load load, Make make, Evict evict) {
+    constexpr int keys = 20000;
+    constexpr std::size_t capacity = 4096;
+    constexpr std::size_t held = 1024;
+
+    std::unordered_map<int, Entry> cache;
+    std::vector<Handle> recent(held);
+    std::mt19937 rng(42);
+    long long hits = 0;
+    long long lookups = 0;
+
+    for (auto _ : state) {
+        int key = static_cast<int>(rng() % keys);
+        Handle handle;
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            handle = load(it->second);
+        }
+        if (handle) {
+            ++hits;
+        } else {
+            handle = make(key);
+            cache[key] = Entry(handle);
+        }
+        recent[lookups++ % held] = std::move(handle);
+
+        if (cache.size() > capacity) {
+            evict(cache);
+        }
+    }
+    state.counters["hit_rate"] = lookups ? static_cast<double>(hits) / lookups : 0.0;
+}
+
+static void BM_cache_weak_ptr(benchmark::State& state) {
+    // Weak entries expire once no caller holds them; sweep the dead ones
+    run_cache<SharedPtr<CachedRecord>, WeakPtr<CachedRecord>>(state,
+        [](const WeakPtr<CachedRecord>& e) { return e.lock(); },
+        [](int key) { return make_shared<CachedRecord>(key); },
+        [](auto& cache) {
+            for (auto it = cache.begin(); it != cache.end();) {
+                it = it->second.expired() ? cache.erase(it) : std::next(it);
+            }
+        });
+}
+BENCHMARK(BM_cache_weak_ptr);
+
+// Strong entries keep objects alive, so the cache has to drop one itself
+static void BM_cache_shared_ptr(benchmark::State& state) {
+    run_cache<SharedPtr<CachedRecord>, SharedPtr<CachedRecord>>(state,
+        [](const SharedPtr<CachedRecord>& e) { return e; },
+        [](int key) { return make_shared<CachedRecord>(key); },
+        [](auto& cache) { cache.erase(cache.begin()); });
+}
+BENCHMARK(BM_cache_shared_ptr);
+
+static void BM_cache_intrusive_ptr(benchmark::State& state) {
+    run_cache<IntrusivePtr<CachedRecord>, IntrusivePtr<CachedRecord>>(state,
+        [](const IntrusivePtr<CachedRecord>& e) { return e; },
+        [](int key) { return make_intrusive<CachedRecord>(key); },
+        [](auto& cache) { cache.erase(cache.begin()); });
+}
+BENCHMARK(BM_cache_intrusive_ptr);
+
+struct Config {
+    int version;
+    int limits[15];
+
+    explicit Config(int v) : version(v), limits{} {}
+};
+
+// Every thread reads the current config; thread 0 also republishes it
+// every 256 reads, so readers race with a writer
+constexpr int republish_every = 256;
+
+static void BM_publish_atomic_shared_ptr(benchmark::State& state) {
+    static AtomicSharedPtr<Config> published;
+    if (state.thread_index() == 0) published.store(make_shared<Config>(0));
+    int reads = 0;
+    for (auto _ : state) {
+        SharedPtr<Config> config = published.load();
+        benchmark::DoNotOptimize(config->version);
+        if (state.thread_index() == 0 && ++reads % republish_every == 0) {
+            published.store(make_shared<Config>(reads));
+        }
+    }
+}
+BENCHMARK(BM_publish_atomic_shared_ptr)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_publish_std_atomic_load(benchmark::State& state) {
+    static std::shared_ptr<Config> published;
+    if (state.thread_index() == 0) std::atomic_store(&published, std::make_shared<Config>(0));
+    int reads = 0;
+    for (auto _ : state) {
+        std::shared_ptr<Config> config = std::atomic_load(&published);
+        benchmark::DoNotOptimize(config->version);
+        if (state.thread_index() == 0 && ++reads % republish_every == 0) {
+            std::atomic_store(&published, std::make_shared<Config>(reads));
+        }
+    }
+}
+BENCHMARK(BM_publish_std_atomic_load)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_publish_mutex(benchmark::State& state) {
+    static std::mutex mutex;
+    static SharedPtr<Config> published;
+    if (state.thread_index() == 0) published = make_shared<Config>(0);
+    int reads = 0;
+    for (auto _ : state) {
+        SharedPtr<Config> config;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            config = published;
+        }
+        benchmark::DoNotOptimize(config->version);
+        if (state.thread_index() == 0 && ++reads % republish_every == 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            published = make_shared<Config>(reads);
+        }
+    }
+}
+BENCHMARK(BM_publish_mutex)->ThreadRange(1, 64)->UseRealTime();
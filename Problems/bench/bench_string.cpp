@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "string.hpp"
+
+static const char line[] = "(42, u1, u2, 10, 108)\n";
+
+// Builds a report of range(0) lines by repeated concatenation
+static void BM_concat_std_string(benchmark::State& state) {
+    for (auto _ : state) {
+        std::string out;
+        for (int i = 0; i < state.range(0); ++i) out += line;
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_concat_std_string)->Arg(5000);
+
+static void BM_concat_operator_plus(benchmark::State& state) {
+    const String piece(line);
+    for (auto _ : state) {
+        String out;
+        for (int i = 0; i < state.range(0); ++i) out = out + piece;
+        benchmark::DoNotOptimize(out.c_str());
+    }
+}
+BENCHMARK(BM_concat_operator_plus)->Arg(5000);
+
+static void BM_concat_string_builder(benchmark::State& state) {
+    const String piece(line);
+    for (auto _ : state) {
+        StringBuilder out;
+        for (int i = 0; i < state.range(0); ++i) out += piece;
+        String result = out.release();
+        benchmark::DoNotOptimize(result.c_str());
+    }
+}
+BENCHMARK(BM_concat_string_builder)->Arg(5000);
+
+static void BM_concat_rope(benchmark::State& state) {
+    const String piece(line);
+    for (auto _ : state) {
+        Rope out;
+        for (int i = 0; i < state.range(0); ++i) out += piece;
+        benchmark::DoNotOptimize(out.c_str()); // Includes the final flatten
+    }
+}
+BENCHMARK(BM_concat_rope)->Arg(5000);
+
+// Copies a batch of transaction ids; with threads the copies share refcounts
+template <typename Str>
+static void BM_copy_ids(benchmark::State& state) {
+    static std::vector<Str> ids = [] {
+        std::vector<Str> made;
+        for (int i = 0; i < 1000; ++i) {
+            made.push_back(Str(("transaction-id-" + std::to_string(i)).c_str()));
+        }
+        return made;
+    }();
+    for (auto _ : state) {
+        std::vector<Str> copies(ids);
+        benchmark::DoNotOptimize(copies.data());
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK_TEMPLATE(BM_copy_ids, std::string)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_copy_ids, String)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_copy_ids, SharedString)->ThreadRange(1, 4)->UseRealTime();
+
+template <typename Str>
+static void BM_equal_ids(benchmark::State& state) {
+    const Str a("transaction-id-0001"), b("transaction-id-0002");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a == b);
+    }
+}
+BENCHMARK_TEMPLATE(BM_equal_ids, std::string);
+BENCHMARK_TEMPLATE(BM_equal_ids, String);
+BENCHMARK_TEMPLATE(BM_equal_ids, SharedString);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "string_sso.hpp"
+
+// Builds transaction-id style keys ("u" + number), copies them and appends to them
+template <typename Str>
+static void BM_short_keys(benchmark::State& state) {
+    const int keys = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::vector<Str> ids;
+        ids.reserve(keys);
+        for (int i = 0; i < keys; ++i) {
+            Str id("u");
+            id += std::to_string(i).c_str();
+            ids.push_back(id);
+        }
+        std::vector<Str> copies = ids;
+        for (Str& id : copies) id += "-tx";
+        benchmark::DoNotOptimize(copies.data());
+    }
+    state.SetItemsProcessed(state.iterations() * keys);
+}
+BENCHMARK_TEMPLATE(BM_short_keys, std::string)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_short_keys, String)->Arg(10000);
+
+// Pairs of equal-length strings that differ only in the last byte
+template <typename Str>
+static std::pair<Str, Str> make_pair_of(std::size_t length) {
+    std::string base(length, 'a');
+    std::string other = base;
+    other.back() = 'b';
+    return {Str(base.c_str()), Str(other.c_str())};
+}
+
+template <typename Str>
+static void BM_equal(benchmark::State& state) {
+    auto [a, b] = make_pair_of<Str>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a == b);
+    }
+}
+BENCHMARK_TEMPLATE(BM_equal, std::string)->RangeMultiplier(4)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_equal, String)->RangeMultiplier(4)->Range(8, 1024);
+
+template <typename Str>
+static void BM_compare(benchmark::State& state) {
+    auto [a, b] = make_pair_of<Str>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.compare(b));
+    }
+}
+BENCHMARK_TEMPLATE(BM_compare, std::string)->RangeMultiplier(4)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_compare, String)->RangeMultiplier(4)->Range(8, 1024);
+
+template <typename Str>
+static void BM_find(benchmark::State& state) {
+    auto [a, b] = make_pair_of<Str>(state.range(0));
+    const Str needle("aab");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(b);
+        benchmark::DoNotOptimize(b.find(needle));
+    }
+}
+BENCHMARK_TEMPLATE(BM_find, std::string)->RangeMultiplier(4)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_find, String)->RangeMultiplier(4)->Range(8, 1024);
+
+static void BM_hash_std_string(benchmark::State& state) {
+    auto [a, b] = make_pair_of<std::string>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(std::hash<std::string>{}(a));
+    }
+}
+BENCHMARK(BM_hash_std_string)->RangeMultiplier(4)->Range(8, 1024);
+
+static void BM_hash_string(benchmark::State& state) {
+    auto [a, b] = make_pair_of<String>(state.range(0));
+    state.SetLabel(string_kernels::active_isa());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.hash());
+    }
+}
+BENCHMARK(BM_hash_string)->RangeMultiplier(4)->Range(8, 1024);
@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#include "up.hpp"
+
+// Same shape as a Filter transaction with inline ids
+struct txn_record {
+    int id;
+    char from_id[16];
+    char to_id[16];
+    int amount;
+    int timestamp;
+};
+
+static_assert(sizeof(unique_pointer<txn_record>) == sizeof(std::unique_ptr<txn_record>), "no overhead over std");
+
+template <typename Ptr>
+static void BM_create(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        Ptr p(new txn_record{i, {}, {}, i % 100, i});
+        ++i;
+        benchmark::DoNotOptimize(p.get());
+    }
+}
+BENCHMARK_TEMPLATE(BM_create, std::unique_ptr<txn_record>);
+BENCHMARK_TEMPLATE(BM_create, unique_pointer<txn_record>);
+
+template <typename Ptr>
+static void BM_move_chain(benchmark::State& state) {
+    Ptr p(new txn_record{1, {}, {}, 1, 1});
+    for (auto _ : state) {
+        Ptr q = std::move(p);
+        benchmark::DoNotOptimize(q.get());
+        p = std::move(q);
+    }
+}
+BENCHMARK_TEMPLATE(BM_move_chain, std::unique_ptr<txn_record>);
+BENCHMARK_TEMPLATE(BM_move_chain, unique_pointer<txn_record>);
+
+template <typename T>
+struct malloc_delete {
+    void operator() (T* ptr) const noexcept {
+        ptr->~T();
+        std::free(ptr);
+    }
+};
+
+struct malloc_allocator {
+    using handle = unique_pointer<txn_record, malloc_delete<txn_record>>;
+
+    static handle make(int id) {
+        void* mem = std::malloc(sizeof(txn_record));
+        if (!mem) throw std::bad_alloc();
+        return handle{new (mem) txn_record{id, {}, {}, id % 100, id}};
+    }
+};
+
+struct free_list_allocator {
+    using handle = free_list_pool<txn_record>::handle;
+
+    static handle make(int id) {
+        thread_local free_list_pool<txn_record> pool;
+        return pool.make(txn_record{id, {}, {}, id % 100, id});
+    }
+};
+
+struct pool_allocator {
+    using handle = object_pool<txn_record>::handle;
+
+    static handle make(int id) {
+        return object_pool<txn_record>::make(txn_record{id, {}, {}, id % 100, id});
+    }
+};
+
+// Allocate a batch, then free it, on the same thread
+template <typename Allocator>
+static void BM_local_churn(benchmark::State& state) {
+    std::vector<typename Allocator::handle> batch;
+    batch.reserve(state.range(0));
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); ++i) batch.push_back(Allocator::make(i));
+        batch.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_local_churn, malloc_allocator)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_local_churn, free_list_allocator)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_local_churn, pool_allocator)->Arg(2048);
+
+// Times every 16th operation so the tail can be reported without the
+// clock reads dominating the measurement
+class latency_sampler {
+public:
+    template <typename Op>
+    void run(Op op) {
+        if (++count % 16 != 0) {
+            op();
+            return;
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        op();
+        samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count());
+    }
+
+    double percentile(double p) {
+        if (samples.empty()) return 0.0;
+        std::sort(samples.begin(), samples.end());
+        return samples[static_cast<std::size_t>(p * (samples.size() - 1))];
+    }
+
+private:
+    std::vector<double> samples;
+    std::size_t count = 0;
+};
+
+// Every thread allocates a batch into its own slot, then frees the batch its
+// neighbour left in the next slot, so all frees are cross-thread. A slot is
+// refilled only after its consumer emptied it.
+template <typename Allocator>
+static void BM_cross_thread_churn(benchmark::State& state) {
+    using handle = typename Allocator::handle;
+    constexpr int batch = 512;
+    constexpr int max_threads = 8;
+    struct slot {
+        std::vector<handle> handles;
+        std::atomic<bool> full{false};
+    };
+    static slot slots[max_threads];
+
+    const int t = state.thread_index();
+    slot& mine = slots[t];
+    slot& theirs = slots[(t + 1) % state.threads()];
+    latency_sampler latency;
+
+    for (auto _ : state) {
+        while (mine.full.load(std::memory_order_acquire)) std::this_thread::yield();
+        for (int i = 0; i < batch; ++i) {
+            latency.run([&] { mine.handles.push_back(Allocator::make(i)); });
+        }
+        mine.full.store(true, std::memory_order_release);
+
+        while (!theirs.full.load(std::memory_order_acquire)) std::this_thread::yield();
+        for (handle& h : theirs.handles) {
+            latency.run([&] { h.reset(); });
+        }
+        theirs.handles.clear();
+        theirs.full.store(false, std::memory_order_release);
+    }
+    state.SetItemsProcessed(state.iterations() * batch * 2);
+    state.counters["p50_ns"] = benchmark::Counter(latency.percentile(0.5), benchmark::Counter::kAvgThreads);
+    state.counters["p99_ns"] = benchmark::Counter(latency.percentile(0.99), benchmark::Counter::kAvgThreads);
+    state.counters["p999_ns"] = benchmark::Counter(latency.percentile(0.999), benchmark::Counter::kAvgThreads);
+}
+BENCHMARK_TEMPLATE(BM_cross_thread_churn, malloc_allocator)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_cross_thread_churn, pool_allocator)->ThreadRange(1, 8)->UseRealTime();
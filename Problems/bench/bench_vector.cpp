@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "vector.hpp"
+
+// Count heap allocations so the small-collection benchmarks can report them.
+// The whole family is replaced, array and sized forms included, so every
+// new is paired with the delete that matches it.
+static std::size_t allocation_count = 0;
+
+static void* counted_allocate(std::size_t size) {
+    ++allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) {
+    return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// Builds a short-lived vector of range(0) elements
+template <typename Vec>
+static void BM_small_collection(benchmark::State& state) {
+    const int elements = static_cast<int>(state.range(0));
+    std::size_t allocations_before = allocation_count;
+    for (auto _ : state) {
+        Vec v;
+        for (int j = 0; j < elements; ++j) {
+            v.push_back(j);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocation_count - allocations_before),
+                                                  benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(BM_small_collection, std::vector<int>)->Arg(2)->Arg(6)->Arg(16);
+BENCHMARK_TEMPLATE(BM_small_collection, Vector<int>)->Arg(2)->Arg(6)->Arg(16);
+BENCHMARK_TEMPLATE(BM_small_collection, SmallVector<int, 8>)->Arg(2)->Arg(6)->Arg(16);
+
+template <typename Vec>
+static Vec make_filled(std::size_t n) {
+    Vec v;
+    for (std::size_t i = 0; i < n; ++i) {
+        v.push_back(static_cast<int>(i & 0xff));
+    }
+    return v;
+}
+
+template <typename Vec>
+static void BM_sum_at(benchmark::State& state) {
+    const Vec v = make_filled<Vec>(state.range(0));
+    for (auto _ : state) {
+        int sum = 0;
+        for (std::size_t i = 0; i < v.size(); ++i) sum += v.at(i);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_sum_at, std::vector<int>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sum_at, Vector<int>)->Arg(1 << 16);
+
+template <typename Vec>
+static void BM_sum_index(benchmark::State& state) {
+    const Vec v = make_filled<Vec>(state.range(0));
+    for (auto _ : state) {
+        int sum = 0;
+        for (std::size_t i = 0; i < v.size(); ++i) sum += v[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_sum_index, std::vector<int>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sum_index, Vector<int>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sum_index, Vector<int, assert_bounds>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sum_index, Vector<int, hardened_bounds>)->Arg(1 << 16);
+
+template <typename Vec>
+static void BM_sum_range_for(benchmark::State& state) {
+    const Vec v = make_filled<Vec>(state.range(0));
+    for (auto _ : state) {
+        int sum = 0;
+        for (int x : v) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_sum_range_for, std::vector<int>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sum_range_for, Vector<int>)->Arg(1 << 16);
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON results and flag regressions.
+
+Usage:
+    compare.py BASELINE CONTENDER [--threshold PERCENT] [--metric real_time|cpu_time]
+
+BASELINE and CONTENDER are either two JSON files written with
+--benchmark_out_format=json, or two directories of them (as written by the
+run_benchmarks target), in which case files are paired by name.
+
+When a benchmark was run with repetitions, its mean aggregate is used.
+Exits with status 1 if any benchmark got slower by more than the threshold.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+
+def load_times(path, metric):
+    with open(path) as f:
+        text = f.read()
+    # A run whose --benchmark_filter matched nothing leaves an empty file
+    report = json.loads(text) if text.strip() else {}
+    times = {}
+    means = {}
+    for bench in report.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        name = bench.get("run_name", bench["name"])
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "mean":
+                means[name] = bench[metric]
+        else:
+            times.setdefault(name, bench[metric])
+    times.update(means)
+    return times
+
+
+def paired_files(baseline, contender):
+    if os.path.isfile(baseline) and os.path.isfile(contender):
+        return [(os.path.basename(contender), baseline, contender)]
+    if os.path.isdir(baseline) and os.path.isdir(contender):
+        names = sorted(n for n in os.listdir(contender) if n.endswith(".json"))
+        return [(n, os.path.join(baseline, n), os.path.join(contender, n))
+                for n in names if os.path.isfile(os.path.join(baseline, n))]
+    sys.exit("compare.py: expected two files or two directories")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown in percent that counts as a regression (default 5)")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time")
+    args = parser.parse_args()
+
+    regressions = []
+    for file_name, baseline_path, contender_path in paired_files(args.baseline, args.contender):
+        before = load_times(baseline_path, args.metric)
+        after = load_times(contender_path, args.metric)
+        print(file_name)
+        for name, new in after.items():
+            old = before.get(name)
+            if old is None or old == 0:
+                print(f"  {name:<60} {'new':>10}")
+                continue
+            change = (new - old) / old * 100
+            flag = ""
+            if change > args.threshold:
+                flag = "  REGRESSION"
+                regressions.append((file_name, name, change))
+            print(f"  {name:<60} {old:>12.2f} -> {new:>12.2f} {change:>+8.1f}%{flag}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower by more than {args.threshold}%:")
+        for file_name, name, change in regressions:
+            print(f"  {file_name}: {name} ({change:+.1f}%)")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())